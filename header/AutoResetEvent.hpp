@@ -0,0 +1,138 @@
+/*
+ * \file AutoResetEvent.hpp
+ * \brief Header file de::Koesling::Threading::AutoResetEvent
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Event that is reset automatically when a thread is released (one-shot event), based on linux futexes
+ *
+ * set() releases exactly one waiting thread. If no thread is waiting, the event stays set until the next thread
+ * waits for it. Setting an event that is already set has no effect.
+ * is_set() is a single atomic load and set() only performs a system call if threads are suspended.
+ */
+class AutoResetEvent final
+{
+    private:
+        //! state of the event (futex word), 0: not set, 1: set
+        std::atomic<int> state;
+
+        //! number of threads currently suspended
+        std::atomic<int> waiters;
+
+        //! try to consume the event without blocking
+        inline bool try_acquire( ) noexcept;
+
+    public:
+        /*! Create a new AutoResetEvent
+         *
+         * attributes:
+         *      - initial_state: true: the event is set
+         */
+        explicit AutoResetEvent(bool initial_state = false) noexcept;
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~AutoResetEvent( ) = default;
+
+        //! Copying not allowed for objects of this type
+        AutoResetEvent(AutoResetEvent &other) = delete;
+        //! Copying not allowed for objects of this type
+        AutoResetEvent& operator=(AutoResetEvent &other) = delete;
+
+        //! move everything to a new object
+        AutoResetEvent(AutoResetEvent &&other) noexcept;
+
+        //! move everything to a new object
+        AutoResetEvent& operator=(AutoResetEvent &&other) noexcept;
+
+        /*! wait until the event is set and reset it (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait( );
+
+        /*! reset the event if it is set
+         *
+         * return value:
+         *      true : the event was set
+         *      false: the event is not set
+         */
+        bool trywait( ) noexcept;
+
+        /*! wait until the event is set and reset it (with timeout)
+         *
+         * attributes:
+         *      - time: maximum time to wait for the event
+         *
+         * return value:
+         *      true : the event was set
+         *      false: the event was not set within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! set the event and release one waiting thread
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void set( );
+
+        //! reset the event
+        inline void reset( ) noexcept;
+
+        //! check if the event is set
+        inline bool is_set( ) const noexcept;
+
+        //! get the number of threads waiting for this event
+        inline unsigned int get_thread_queue( ) const noexcept;
+};
+
+inline bool AutoResetEvent::try_acquire( ) noexcept
+{
+    int expected = 1;
+    return state.compare_exchange_strong(expected, 0, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+inline void AutoResetEvent::reset( ) noexcept
+{
+    state.store(0, std::memory_order_relaxed);
+}
+
+inline bool AutoResetEvent::is_set( ) const noexcept
+{
+    return state.load(std::memory_order_acquire) == 1;
+}
+
+inline unsigned int AutoResetEvent::get_thread_queue( ) const noexcept
+{
+    return static_cast<unsigned int>(waiters.load(std::memory_order_relaxed));
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
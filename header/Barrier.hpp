@@ -0,0 +1,115 @@
+/*
+ * \file Barrier.hpp
+ * \brief Header file de::Koesling::Threading::Barrier
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Reusable sense-reversing barrier based on linux futexes
+ *
+ * A fixed number of threads wait for each other. Once the last thread arrived, the optional completion function is
+ * executed by this thread and all threads are released. The barrier is reset automatically for the next phase.
+ * Waiting threads spin briefly before they are suspended.
+ */
+class Barrier final
+{
+    public:
+        //! type of the completion function
+        typedef std::function<void()> completion_function_t;
+
+    private:
+        //! number of threads that did not arrive in the current phase yet
+        std::atomic<int> remaining;
+
+        //! sense of the current phase (futex word), flipped by the last arriving thread
+        std::atomic<int> sense;
+
+        //! number of threads currently suspended
+        std::atomic<int> waiters;
+
+        //! number of threads per phase
+        int thread_count;
+
+        //! executed by the last arriving thread before the others are released
+        completion_function_t completion;
+
+        /*! reset the barrier for the next phase and release the waiting threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void release(int new_sense);
+
+    public:
+        /*! Create a new Barrier
+         *
+         * attributes:
+         *      - count     : number of threads that have to arrive
+         *      - completion: function executed by the last arriving thread of each phase (optional)
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid count (0 or larger than INT_MAX)
+         */
+        explicit Barrier(unsigned int count, completion_function_t completion = nullptr);
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~Barrier( ) = default;
+
+        //! Copying not allowed for objects of this type
+        Barrier(Barrier &other) = delete;
+        //! Copying not allowed for objects of this type
+        Barrier& operator=(Barrier &other) = delete;
+
+        //! move everything to a new object
+        Barrier(Barrier &&other) noexcept;
+
+        //! move everything to a new object
+        Barrier& operator=(Barrier &&other) noexcept;
+
+        /*! arrive at the barrier and wait for the other threads
+         *
+         * If the completion function throws an exception, the other threads are released anyway and the exception
+         * is passed to the last arriving thread.
+         *
+         * return value:
+         *      true : the calling thread arrived last (and executed the completion function)
+         *      false: otherwise
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         *      - any exception thrown by the completion function
+         */
+        bool arrive_and_wait( );
+
+        //! get the number of threads per phase
+        inline unsigned int get_thread_count( ) const noexcept;
+};
+
+inline unsigned int Barrier::get_thread_count( ) const noexcept
+{
+    return static_cast<unsigned int>(thread_count);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
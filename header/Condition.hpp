@@ -15,7 +15,11 @@
 
 #pragma once
 
-#include <pthread.h>
+#include "Mutex.hpp"
+#include "StopToken.hpp"
+
+#include <atomic>
+#include <ctime>
 #include <string>
 #include <ostream>
 
@@ -23,7 +27,7 @@ namespace de {
 namespace Koesling {
 namespace Threading {
 
-    /*! \brief Condition variable based on pthread_cond
+    /*! \brief Condition variable based on linux futexes
      *
      * A condition (short for ``condition variable'') is a synchronization
      * device that allows threads to suspend execution and relinquish the
@@ -32,40 +36,184 @@ namespace Threading {
      * signal the condition (when the predicate becomes true), and wait for the
      * condition, suspending the thread execution until another thread signals
      * the condition. (see man pthread_cond_xxx)
+     *
+     * Restarted threads are not woken all at once. They are moved to the futex
+     * of the internal lock (wait morphing) and continue one after another when
+     * the lock is released, so they do not contend for it.
+     * Waits with a user supplied Mutex lock the Mutex after the internal lock
+     * was released. The Mutex is a pthread mutex whose futex word is private
+     * to the C library, so restarted threads can not be moved to it and
+     * contend for it like for a pthread_cond_broadcast.
+     *
+     * Waiting threads are restarted in the order they started waiting: threads
+     * that started waiting between two calls of notify() form a group, the
+     * oldest groups are restarted first. Every restart wakes exactly one
+     * thread that started waiting before it. A whole group is moved to the
+     * futex of the internal lock with a single system call.
+     *
+     * Waits with a time span always use CLOCK_MONOTONIC and are not affected
+     * by changes of the system time. The clock of the absolute deadlines
+     * passed to wait_until is selected by the constructor.
      */
     class Condition
     {
         private:
-            /*! \brief Associated mutex
+            /*! \brief Group of waiting threads
+             *
+             * The threads that started waiting between two calls of notify()
+             * sleep on the futex word of the same group. notify() moves the
+             * restarted threads of a group to the futex of the internal lock
+             * with a single FUTEX_CMP_REQUEUE. Each restart is consumed by
+             * exactly one member of the group.
+             *
+             * Threads that wait with a StopToken get a group of their own, so
+             * a stop request wakes only the stopped thread.
+             *
+             * All members are protected by the internal lock (except word).
+             * invariant: waiting + restarts (+ 1 if interrupted) == members
+             */
+            struct group_t
+            {
+                //! futex word, incremented to wake the members
+                std::atomic<int> word;
+                //! members that were not restarted yet
+                size_t waiting;
+                //! restarts that were not consumed by a member yet
+                size_t restarts;
+                //! threads that did not leave the group yet
+                size_t members;
+                //! true: new waiting threads may join the group
+                bool open;
+                //! true: the (only) member was restarted by a stop request
+                bool interrupted;
+                //! next (younger) group, next unused group in the free list
+                group_t *next;
+                //! previous (older) group
+                group_t *prev;
+            };
+
+            /*! \brief Internal lock (futex word)
              *
-             * A condition variable must always be associated with a mutex, to
-             * avoid the race condition where a thread prepares to wait on a
-             * condition variable and another thread signals the condition just
-             * before the first  thread  actually waits on it.
-             * (see man pthread_cond_xxx)
+             * Protects the list of waiting threads and avoids the race
+             * condition where a thread prepares to wait on the condition and
+             * another thread signals the condition just before the first
+             * thread actually waits on it.
+             *
+             * 0: unlocked, 1: locked, 2: locked and threads might be waiting
              */
-            pthread_mutex_t mutex;
+            std::atomic<int> lock_word;
 
-            //! condition variable
-            pthread_cond_t condition;
+            /*! \brief Oldest group of waiting threads
+             *
+             * Threads are restarted in the order they started waiting. A
+             * thread that starts waiting after a signal or broadcast is never
+             * restarted by it.
+             */
+            group_t *head;
 
-            //! signal indicator to avoid spurious wakeup
-            volatile bool signal_created;
+            //! Youngest group of waiting threads
+            group_t *tail;
 
-            //! Number of threads waiting for this condition
-            volatile size_t waiting_thread_count;
+            //! Unused groups (singly linked by next), reused by later waits
+            group_t *free_groups;
 
-            //! indicates whether signal or broadcast was used
-            volatile bool wakeup_by_brodcast;
+            //! Number of threads that are inside a wait method
+            size_t waiting_thread_count;
+
+            //! Clock of the deadlines passed to wait_until
+            clockid_t clock;
 
             //! error message stream for "non-throwable" errors
             static std::ostream* error_stream;
 
+            /*! \brief Wait once for the condition using a user supplied Mutex
+             *
+             * attributes
+             *   - mutex        : Mutex locked by the calling thread
+             *   - timeout_time : absolute time point, nullptr: no timeout
+             *   - realtime     : true : timeout_time refers to CLOCK_REALTIME
+             *                    false: timeout_time refers to CLOCK_MONOTONIC
+             *   - token        : a stop request restarts the thread,
+             *                    nullptr: none
+             *
+             * return value: false if the timeout expired
+             */
+            bool wait_once(Mutex &mutex, const struct timespec *timeout_time, bool realtime,
+                    const StopToken *token = nullptr);
+
+            //! Predicate wait until the absolute time point deadline (see wait_once)
+            template<typename Predicate>
+            bool wait_deadline(Mutex &mutex, const struct timespec &deadline, bool realtime,
+                    Predicate predicate);
+
+            /*! \brief Suspend the calling thread until it is restarted
+             *
+             * The calling thread joins the youngest group of waiting threads
+             * and is suspended until notify() restarts a member of the group
+             * or the timeout expires.
+             *
+             * attributes
+             *   - mutex        : user supplied Mutex that is released after
+             *                    the thread was added to the list,
+             *                    nullptr: none. The Mutex is not locked again.
+             *   - timeout_time : absolute time point, nullptr: no timeout
+             *   - realtime     : true : timeout_time refers to CLOCK_REALTIME
+             *                    false: timeout_time refers to CLOCK_MONOTONIC
+             *   - token        : a stop request restarts the thread,
+             *                    nullptr: none
+             *
+             * return value: true : thread was restarted by notify() or a
+             *                      stop request
+             *               false: timeout expired
+             */
+            bool suspend(Mutex *mutex, const struct timespec *timeout_time, bool realtime,
+                    const StopToken *token = nullptr);
+
+            /*! \brief Add the calling thread to a group of waiting threads
+             *
+             * The internal lock must be held.
+             *
+             * attributes
+             *   - own : true: create a group that no other thread joins
+             *
+             * possible throws:
+             *   - std::bad_alloc: out of memory
+             */
+            group_t* join_group(bool own);
+
+            //! Remove the calling thread from its group (internal lock must be held)
+            void leave_group(group_t *group) noexcept;
+
+            /*! \brief Restart a waiting thread because of a stop request
+             *
+             * attributes
+             *   - group : group of the waiting thread (protected by the
+             *             internal lock), nullptr: not waiting
+             */
+            void interrupt(group_t *const &group);
+
+            //! Calculate the absolute time point (CLOCK_MONOTONIC) for a timeout of time span time
+            static struct timespec timeout(const struct timespec &time);
+
         public:
-            //! Create a new Condition object
+            //! Create a new Condition object (deadlines refer to CLOCK_REALTIME)
             Condition( ) noexcept;
 
-            //! Destroy a Condition object
+            /*! \brief Create a new Condition object
+             *
+             * attributes
+             *   - clock : clock of the deadlines passed to wait_until
+             *             (CLOCK_REALTIME or CLOCK_MONOTONIC)
+             *
+             * possible throws:
+             *   - std::invalid_argument: unsupported clock
+             */
+            explicit Condition(clockid_t clock);
+
+            /*! Destroy a Condition object
+             *
+             * Terminates the program (EX_SOFTWARE) if threads are still waiting.
+             */
             virtual ~Condition( );
 
             //! Copying not allowed for objects of this type
@@ -87,9 +235,7 @@ namespace Threading {
              *   - std::system_error: A system call failed. An error number is
              *                        set according to <cerrno>.
              *                        possible error numbers see man pages:
-             *                          - pthread_mutex_lock
-             *                          - pthread_mutex_unlock
-             *                          - pthread_cond_wait
+             *                          - futex
              */
             bool wait( );
 
@@ -108,21 +254,138 @@ namespace Threading {
              *   - std::system_error: A system call failed. An error number is
              *                        set according to <cerrno>.
              *                        possible error numbers see man pages:
+             *                          - futex
+             *                          - clock_gettime
+             *   - std::invalid_arg. : the given time span is invalid.
+             */
+            bool wait(const struct timespec &time);
+
+            /*! Waits until the condition variable is signaled or the deadline
+             *  is reached.
+             *
+             * attributes
+             *   - deadline : absolute time point (clock selected by the
+             *                constructor)
+             *
+             * return value: false if the deadline was reached
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man pages:
+             *                          - futex
+             */
+            bool wait_until(const struct timespec &deadline);
+
+            /*! \brief Waits until the predicate is satisfied.
+             *
+             * The caller protects its shared state with its own Mutex. The
+             * Mutex is released atomically while the thread is suspended and
+             * locked again before the predicate is evaluated. Therefore no
+             * second lock is required to check the shared state and to wait.
+             *
+             * Spurious wakeups are handled by evaluating the predicate again.
+             *
+             * attributes
+             *   - mutex     : Mutex that protects the shared state. Must be
+             *                 locked by the calling thread. Is locked when
+             *                 the method returns.
+             *   - predicate : callable that returns true if the thread shall
+             *                 continue. Only called while mutex is locked.
+             *
+             * possible throws:
+             *   - std::logic_error : mutex is not locked by the calling thread
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man pages:
+             *                          - futex
              *                          - pthread_mutex_lock
              *                          - pthread_mutex_unlock
-             *                          - pthread_cond_timedwait
-             *                          - gettimeofday
+             */
+            template<typename Predicate>
+            void wait(Mutex &mutex, Predicate predicate);
+
+            /*! \brief Waits until the predicate is satisfied or a stop is
+             *         requested.
+             *
+             * see wait(Mutex&, Predicate)
+             *
+             * A stop request (see StopSource) restarts the waiting thread,
+             * the thread that requests the stop does not need to know the
+             * Condition.
+             *
+             * attributes
+             *   - mutex     : Mutex that protects the shared state. Must be
+             *                 locked by the calling thread. Is locked when
+             *                 the method returns.
+             *   - token     : stop token
+             *   - predicate : callable that returns true if the thread shall
+             *                 continue. Only called while mutex is locked.
+             *
+             * return value: result of the last evaluation of predicate
+             *               (false: a stop was requested)
+             *
+             * possible throws:
+             *   - std::logic_error : mutex is not locked by the calling thread
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man pages:
+             *                          - futex
+             *                          - pthread_mutex_lock
+             *                          - pthread_mutex_unlock
+             */
+            template<typename Predicate>
+            bool wait(Mutex &mutex, const StopToken &token, Predicate predicate);
+
+            /*! \brief Waits until the predicate is satisfied or the deadline
+             *         is reached.
+             *
+             * see wait(Mutex&, Predicate)
+             *
+             * attributes
+             *   - mutex     : Mutex that protects the shared state. Must be
+             *                 locked by the calling thread. Is locked when
+             *                 the method returns.
+             *   - deadline  : absolute time point (clock selected by the
+             *                 constructor)
+             *   - predicate : callable that returns true if the thread shall
+             *                 continue. Only called while mutex is locked.
+             *
+             * return value: result of the last evaluation of predicate
+             *
+             * possible throws:
+             *   - std::logic_error : mutex is not locked by the calling thread
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man pages:
+             *                          - futex
+             *                          - pthread_mutex_lock
+             *                          - pthread_mutex_unlock
+             */
+            template<typename Predicate>
+            bool wait_until(Mutex &mutex, const struct timespec &deadline, Predicate predicate);
+
+            /*! \brief Waits until the predicate is satisfied or the time span
+             *         expired.
+             *
+             * see wait_until(Mutex&, const timespec&, Predicate)
+             *
+             * attributes
+             *   - time : time span (measured with CLOCK_MONOTONIC)
+             *
+             * possible throws:
              *   - std::invalid_arg. : the given time span is invalid.
              */
-            bool wait(const struct timespec &time);
+            template<typename Predicate>
+            bool wait_for(Mutex &mutex, const struct timespec &time, Predicate predicate);
 
             /*! Restarts one of the threads that are waiting on the condition
              *  variable.
              *
              * If no threads are waiting on the condition variable, nothing
              * happens. If several threads are waiting on the condition
-             * variable, exactly one is restarted, but it is not specified
-             * which.
+             * variable, exactly one is restarted: one of the threads that
+             * started waiting before the previous restart, if there are any.
              *
              * return value: true:  at least one thread could be signaled
              *               false: no thread is waiting for this condition
@@ -131,12 +394,30 @@ namespace Threading {
              *   - std::system_error: A system call failed. An error number is
              *                        set according to <cerrno>.
              *                        possible error numbers see man pages:
-             *                          - pthread_mutex_lock
-             *                          - pthread_mutex_unlock
-             *                          - pthread_cond_signal
+             *                          - futex
              */
             bool signal( );
 
+            /*! \brief Restarts up to n of the threads that are waiting on
+             *         the condition variable.
+             *
+             * Unlike calling signal() n times, the internal lock is locked
+             * only once and, unlike broadcast(), no more than n threads are
+             * restarted.
+             *
+             * attributes
+             *   - n : maximum number of threads to restart
+             *
+             * return value: number of restarted threads
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man pages:
+             *                          - futex
+             */
+            size_t notify(size_t n);
+
             /*! \brief Restarts all the threads that are waiting on the
              *         condition variable.
              *
@@ -150,16 +431,65 @@ namespace Threading {
              *   - std::system_error: A system call failed. An error number is
              *                        set according to <cerrno>.
              *                        possible error numbers see man pages:
-             *                          - pthread_mutex_lock
-             *                          - pthread_mutex_unlock
-             *                          - pthread_cond_broadcast
+             *                          - futex
              */
             bool broadcast( );
 
+            //! Get the clock of the deadlines passed to wait_until
+            inline clockid_t get_clock( ) const noexcept;
+
             //! Set stream for error output for "non-throwable" errors
             inline static void set_error_stream(std::ostream& stream) noexcept;
     };
 
+    template<typename Predicate>
+    void Condition::wait(Mutex &mutex, Predicate predicate)
+    {
+        while (!predicate( ))
+            wait_once(mutex, nullptr, false);
+    }
+
+    template<typename Predicate>
+    bool Condition::wait(Mutex &mutex, const StopToken &token, Predicate predicate)
+    {
+        while (!predicate( ))
+        {
+            if (token.stop_requested( )) return predicate( );
+            wait_once(mutex, nullptr, false, &token);
+        }
+
+        return true;
+    }
+
+    template<typename Predicate>
+    bool Condition::wait_deadline(Mutex &mutex, const struct timespec &deadline, bool realtime,
+            Predicate predicate)
+    {
+        while (!predicate( ))
+        {
+            if (!wait_once(mutex, &deadline, realtime)) return predicate( );
+        }
+
+        return true;
+    }
+
+    template<typename Predicate>
+    bool Condition::wait_until(Mutex &mutex, const struct timespec &deadline, Predicate predicate)
+    {
+        return wait_deadline(mutex, deadline, clock == CLOCK_REALTIME, predicate);
+    }
+
+    template<typename Predicate>
+    bool Condition::wait_for(Mutex &mutex, const struct timespec &time, Predicate predicate)
+    {
+        return wait_deadline(mutex, timeout(time), false, predicate);
+    }
+
+    inline clockid_t Condition::get_clock( ) const noexcept
+    {
+        return clock;
+    }
+
     inline void Condition::set_error_stream(std::ostream& stream) noexcept
     {
         error_stream = &stream;
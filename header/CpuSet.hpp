@@ -0,0 +1,147 @@
+/*
+ * \file CpuSet.hpp
+ * \brief Header file de::Koesling::Threading::CpuSet
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <sched.h>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Set of CPUs (wrapper for cpu_set_t)
+ *
+ * Used to set and get the CPU affinity of threads (see Thread::set_affinity) and returned by Topology.
+ * Supports CPU numbers up to CPU_SETSIZE - 1 (1023).
+ */
+class CpuSet final
+{
+    private:
+        //! actual cpu set
+        cpu_set_t set;
+
+        //! throw std::invalid_argument if cpu is out of range
+        static void check_cpu(unsigned int cpu);
+
+    public:
+        //! Create an empty CpuSet
+        CpuSet( ) noexcept;
+
+        /*! Create a CpuSet that contains the given CPUs
+         *
+         * possible throws:
+         *      - std::invalid_argument: a CPU number is out of range
+         */
+        CpuSet(std::initializer_list<unsigned int> cpus);
+
+        /*! Create a CpuSet that contains the given CPUs
+         *
+         * possible throws:
+         *      - std::invalid_argument: a CPU number is out of range
+         */
+        explicit CpuSet(const std::vector<unsigned int> &cpus);
+
+        //! Create a CpuSet from a cpu_set_t
+        explicit CpuSet(const cpu_set_t &set) noexcept;
+
+        /*! Create a CpuSet from a CPU list (format of the linux kernel, e.g. "0-3,8,10-11")
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid list or CPU number is out of range
+         */
+        static CpuSet from_list(const std::string &list);
+
+        /*! add a CPU
+         *
+         * possible throws:
+         *      - std::invalid_argument: CPU number is out of range
+         */
+        void add(unsigned int cpu);
+
+        /*! remove a CPU
+         *
+         * possible throws:
+         *      - std::invalid_argument: CPU number is out of range
+         */
+        void remove(unsigned int cpu);
+
+        //! check if the set contains a CPU
+        bool contains(unsigned int cpu) const noexcept;
+
+        //! get the number of CPUs in the set
+        std::size_t count( ) const noexcept;
+
+        //! check if the set is empty
+        inline bool empty( ) const noexcept;
+
+        //! get the CPUs in the set (ascending)
+        std::vector<unsigned int> get_cpus( ) const;
+
+        //! get the set as CPU list (format of the linux kernel, e.g. "0-3,8")
+        std::string to_list( ) const;
+
+        //! get the underlying cpu_set_t
+        inline const cpu_set_t& native( ) const noexcept;
+
+        //! get the size of the underlying cpu_set_t (for pthread_*affinity_np)
+        inline static constexpr std::size_t native_size( ) noexcept;
+
+        //! union of two sets
+        CpuSet operator|(const CpuSet &other) const noexcept;
+
+        //! intersection of two sets
+        CpuSet operator&(const CpuSet &other) const noexcept;
+
+        //! compare two sets
+        bool operator==(const CpuSet &other) const noexcept;
+
+        //! compare two sets
+        inline bool operator!=(const CpuSet &other) const noexcept;
+};
+
+//! write a CpuSet as CPU list to an output stream
+std::ostream& operator <<(std::ostream &os, const CpuSet &set);
+
+inline bool CpuSet::empty( ) const noexcept
+{
+    return count() == 0;
+}
+
+inline const cpu_set_t& CpuSet::native( ) const noexcept
+{
+    return set;
+}
+
+inline constexpr std::size_t CpuSet::native_size( ) noexcept
+{
+    return sizeof(cpu_set_t);
+}
+
+inline bool CpuSet::operator!=(const CpuSet &other) const noexcept
+{
+    return !(*this == other);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,179 @@
+/*
+ * \file EventCount.hpp
+ * \brief Header file de::Koesling::Threading::EventCount
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Event count based on linux futexes
+ *
+ * Allows to suspend threads until a condition on lock-free data (e.g. a lock-free queue is not empty) becomes true,
+ * without protecting the data by a lock.
+ *
+ * waiting thread:
+ *      while (!queue.try_pop(item))
+ *      {
+ *          auto key = event_count.prepare_wait();
+ *          if (queue.try_pop(item)) { event_count.cancel_wait(); break; }
+ *          event_count.wait(key);
+ *      }
+ *
+ * notifying thread:
+ *      queue.push(item);
+ *      event_count.notify();
+ *
+ * A notification that happens between prepare_wait() and wait() is not lost: wait() returns immediately.
+ * If no thread is waiting, notify() costs a memory fence and a single atomic load.
+ * wait() might return without a notification for the calling thread. The condition must be checked again.
+ */
+class EventCount final
+{
+    public:
+        //! key returned by prepare_wait()
+        typedef int wait_key_t;
+
+    private:
+        //! incremented by each notification (futex word)
+        std::atomic<int> epoch;
+
+        //! number of threads between prepare_wait() and the end of wait()/cancel_wait()
+        std::atomic<int> waiters;
+
+        /*! start a new epoch and wake up to count threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wake(int count);
+
+    public:
+        //! Create a new EventCount
+        EventCount( ) noexcept;
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~EventCount( ) = default;
+
+        //! Copying not allowed for objects of this type
+        EventCount(EventCount &other) = delete;
+        //! Copying not allowed for objects of this type
+        EventCount& operator=(EventCount &other) = delete;
+
+        //! move everything to a new object
+        EventCount(EventCount &&other) noexcept;
+
+        //! move everything to a new object
+        EventCount& operator=(EventCount &&other) noexcept;
+
+        /*! announce that the calling thread is going to wait
+         *
+         * Must be called before the condition is checked for the last time.
+         * Must be followed by either wait() or cancel_wait().
+         *
+         * return value: key that is passed to wait()
+         */
+        inline wait_key_t prepare_wait( ) noexcept;
+
+        //! the condition became true after prepare_wait(): do not wait
+        inline void cancel_wait( ) noexcept;
+
+        /*! wait for a notification after prepare_wait()
+         *
+         * Returns immediately if a notification happened since prepare_wait().
+         *
+         * attributes:
+         *      - key: value returned by prepare_wait()
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait(wait_key_t key);
+
+        /*! wait for a notification after prepare_wait() (with timeout)
+         *
+         * attributes:
+         *      - key : value returned by prepare_wait()
+         *      - time: maximum time to wait
+         *
+         * return value:
+         *      true : a notification happened since prepare_wait()
+         *      false: the timeout expired
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool wait(wait_key_t key, const timespec &time);
+
+        /*! wake one waiting thread
+         *
+         * Must be called after the condition became true.
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        inline void notify( );
+
+        /*! wake all waiting threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        inline void notify_all( );
+
+        //! get the number of threads that prepared to wait or are waiting
+        inline unsigned int get_thread_queue( ) const noexcept;
+};
+
+inline EventCount::wait_key_t EventCount::prepare_wait( ) noexcept
+{
+    // the increment must be visible before the condition is checked (pairs with the fence in notify)
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    return epoch.load(std::memory_order_seq_cst);
+}
+
+inline void EventCount::cancel_wait( ) noexcept
+{
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+inline void EventCount::notify( )
+{
+    // the change of the condition must be visible before the waiters are checked (pairs with prepare_wait)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) != 0) wake(1);
+}
+
+inline void EventCount::notify_all( )
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) != 0) wake(-1);
+}
+
+inline unsigned int EventCount::get_thread_queue( ) const noexcept
+{
+    return static_cast<unsigned int>(waiters.load(std::memory_order_relaxed));
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
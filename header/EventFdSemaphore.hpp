@@ -0,0 +1,143 @@
+/*
+ * \file EventFdSemaphore.hpp
+ * \brief Header file de::Koesling::Threading::EventFdSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <ctime>
+#include <ostream>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Semaphore based on a linux eventfd (EFD_SEMAPHORE)
+ *
+ * The semaphore provides a file descriptor that can be monitored with poll/select/epoll.
+ * The file descriptor is readable as long as the value of the semaphore is greater than zero.
+ * This allows to wait for the semaphore and other file descriptors (e.g. sockets) with a single system call.
+ * If the file descriptor signals readability, use trywait() to acquire the semaphore, since another thread could have
+ * acquired it in the meantime.
+ *
+ * The file descriptor is non blocking and closed on exec.
+ */
+class EventFdSemaphore final
+{
+    private:
+        //! eventfd file descriptor
+        int fd;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+        /*! wait until the file descriptor is readable
+         *
+         * attributes:
+         *      - timeout_time: absolute time point (CLOCK_MONOTONIC), nullptr: no timeout
+         *
+         * return value: false if the timeout expired
+         */
+        bool poll_readable(const timespec *timeout_time);
+
+    public:
+        /*! Create a new EventFdSemaphore
+         *
+         * attributes:
+         *      - value: initial value of this semaphore
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        explicit EventFdSemaphore(unsigned int value);
+
+        //! Destroy Object (close the file descriptor), not virtual because object is final and does not inherit
+        ~EventFdSemaphore( );
+
+        //! Copying not allowed for objects of this type
+        EventFdSemaphore(EventFdSemaphore &other) = delete;
+        //! Copying not allowed for objects of this type
+        EventFdSemaphore& operator=(EventFdSemaphore &other) = delete;
+
+        //! move everything to a new object
+        EventFdSemaphore(EventFdSemaphore &&other) noexcept;
+
+        //! move everything to a new object
+        EventFdSemaphore& operator=(EventFdSemaphore &&other) noexcept;
+
+        /*! wait for this semaphore (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait();
+
+        /*! try to get this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore is currently not available
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool trywait();
+
+        /*! wait for this semaphore (with timeout)
+         *
+         * attributes:
+         *      - time: maximum time to wait for this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore was not available within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! post this semaphore
+         *
+         * attributes:
+         *      - n: value to add to the semaphore
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void post(unsigned int n = 1);
+
+        //! get the file descriptor (for poll/select/epoll)
+        inline int get_fd( ) const noexcept;
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+inline int EventFdSemaphore::get_fd( ) const noexcept
+{
+    return fd;
+}
+
+inline void EventFdSemaphore::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
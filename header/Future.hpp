@@ -0,0 +1,761 @@
+/*
+ * \file Future.hpp
+ * \brief Header file de::Koesling::Threading::Future, de::Koesling::Threading::Promise, when_all and when_any
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+template<typename T> class Future;
+template<typename T> class Promise;
+template<typename T> struct when_any_result;
+
+template<typename T> Future<std::vector<Future<T>>> when_all(std::vector<Future<T>> futures);
+template<typename T> Future<when_any_result<T>> when_any(std::vector<Future<T>> futures);
+
+//! internal types of Future and Promise
+namespace future_internal {
+
+/*! \brief Type independent part of the state shared by a Promise and its Future
+ *
+ * The state becomes ready once a value or an exception is stored. Threads that wait for the state are suspended on a
+ * futex. Continuations that are added before the state is ready are executed (in the order they were added) by the
+ * thread that makes it ready, a continuation that is added afterwards is executed immediately. A state can have
+ * several continuations: e.g. the continuation of a when_any() that the state lost and the one added by then().
+ */
+class shared_state_base
+{
+    private:
+        //! state of the shared state
+        enum state_t : int
+        {
+            PENDING = 0,    //!< no value or exception stored
+            WAITING = 1,    //!< no value or exception stored, threads might be waiting
+            READY   = 2     //!< value or exception stored
+        };
+
+        //! futex word, see state_t
+        std::atomic<int> state;
+
+        //! set by the first call of claim()
+        std::atomic<bool> satisfied;
+
+        //! protects continuations (futex word, see futex_lock)
+        std::atomic<int> lock_word;
+
+        //! executed once the state is ready
+        std::vector<std::function<void()>> continuations;
+
+        //! exception stored instead of a value
+        std::exception_ptr exception;
+
+    protected:
+        //! Create a new (pending) shared state
+        shared_state_base( ) noexcept;
+
+        /*! mark the state as ready, wake waiting threads and execute the continuations
+         *
+         * The value or exception must be stored before. If a continuation throws, the remaining continuations are
+         * executed anyway and the first exception is rethrown afterwards.
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void make_ready( );
+
+        /*! store an exception and make the state ready (state must be claimed)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void fail(std::exception_ptr exception);
+
+    public:
+        //! Destroy Object
+        virtual ~shared_state_base( ) = default;
+
+        //! Copying not allowed for objects of this type
+        shared_state_base(shared_state_base &other) = delete;
+        //! Copying not allowed for objects of this type
+        shared_state_base& operator=(shared_state_base &other) = delete;
+
+        //! Moving not allowed for objects of this type
+        shared_state_base(shared_state_base &&other) = delete;
+        //! Moving not allowed for objects of this type
+        shared_state_base& operator=(shared_state_base &&other) = delete;
+
+        /*! reserve the state for storing a value or exception
+         *
+         * possible throws:
+         *      - std::future_error: promise_already_satisfied
+         */
+        void claim( );
+
+        /*! store an exception and make the state ready
+         *
+         * possible throws:
+         *      - std::future_error: promise_already_satisfied
+         *      - std::system_error: a system call failed
+         */
+        void set_exception(std::exception_ptr exception);
+
+        /*! wait until the state is ready
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait( );
+
+        /*! wait until the state is ready or the time span expired
+         *
+         * return value: false if the time span expired
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool wait_for(const timespec &time);
+
+        //! check if the state is ready
+        bool is_ready( ) const noexcept;
+
+        //! check if a value or exception was stored or is being stored
+        bool is_satisfied( ) const noexcept;
+
+        //! rethrow the stored exception (state must be ready)
+        void rethrow( ) const;
+
+        /*! execute function once the state is ready
+         *
+         * function is executed immediately by the calling thread if the state is already ready, otherwise by the
+         * thread that makes the state ready.
+         *
+         * possible throws:
+         *      - std::bad_alloc: out of memory
+         *      - any exception thrown by function if it is executed immediately
+         */
+        void add_continuation(std::function<void()> function);
+};
+
+//! state shared by Promise<T> and Future<T>
+template<typename T>
+class shared_state final : public shared_state_base
+{
+    private:
+        //! storage for the value
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        //! true if storage contains a value
+        bool has_value;
+
+    public:
+        shared_state( ) noexcept :
+                has_value(false)
+        { }
+
+        ~shared_state( ) override
+        {
+            if (has_value) reinterpret_cast<T*>(&storage)->~T();
+        }
+
+        //! store the value (constructed from args) and make the state ready
+        template<typename... Args>
+        void set_value(Args&&... args)
+        {
+            claim();
+            try
+            {
+                new (&storage) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                // the state is claimed: the future receives the exception of the constructor
+                fail(std::current_exception());
+                throw;
+            }
+            has_value = true;
+            make_ready();
+        }
+
+        //! move the value out of the state (state must be ready)
+        T take( )
+        {
+            rethrow();
+            return std::move(*reinterpret_cast<T*>(&storage));
+        }
+};
+
+//! state shared by Promise<void> and Future<void>
+template<>
+class shared_state<void> final : public shared_state_base
+{
+    public:
+        shared_state( ) noexcept = default;
+
+        //! make the state ready
+        void set_value( )
+        {
+            claim();
+            make_ready();
+        }
+
+        //! check the result (state must be ready)
+        void take( )
+        {
+            rethrow();
+        }
+};
+
+//! store the result of function(args...) in state (void results)
+template<typename Function, typename... Args>
+void fulfill(shared_state<void> &state, Function &function, Args&&... args)
+{
+    try
+    {
+        function(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        state.set_exception(std::current_exception());
+        return;
+    }
+    state.set_value();
+}
+
+//! store the result of function(args...) in state
+template<typename R, typename Function, typename... Args>
+void fulfill(shared_state<R> &state, Function &function, Args&&... args)
+{
+    try
+    {
+        state.set_value(function(std::forward<Args>(args)...));
+    }
+    catch (...)
+    {
+        // exception of the constructor of R: already stored by set_value
+        if (!state.is_satisfied()) state.set_exception(std::current_exception());
+    }
+}
+
+} /* namespace future_internal */
+
+/*! \brief Result of an asynchronous operation
+ *
+ * A Future is created by Promise::get_future() or by then(). The result is retrieved once with get(), which blocks
+ * until the result is available and rethrows the exception stored by the promise.
+ *
+ * then() attaches a continuation that is executed once the result is available, without blocking a thread. The
+ * continuation is called with the ready Future (get() does not block and rethrows the exception of the operation) and
+ * its return value becomes the result of the Future returned by then(). If the continuation throws an exception, the
+ * exception becomes the result.
+ *
+ * Futures are not copyable. get() and then() consume the Future, afterwards valid() returns false.
+ *
+ * template arguments:
+ *      - T: type of the result (void: no result)
+ */
+template<typename T>
+class Future final
+{
+    private:
+        //! state shared with the promise, nullptr: not valid
+        std::shared_ptr<future_internal::shared_state<T>> state;
+
+        //! create a future for a state
+        explicit Future(std::shared_ptr<future_internal::shared_state<T>> state) noexcept;
+
+        //! throw std::future_error(no_state) if the future is not valid
+        void check_valid( ) const;
+
+        //! consume the future, add function as continuation and return the future of its result
+        template<typename Function, typename Schedule>
+        auto chain(Function &&function, Schedule schedule) -> Future<decltype(function(std::declval<Future<T>>()))>;
+
+        template<typename U> friend class Future;
+        template<typename U> friend class Promise;
+        template<typename U> friend Future<std::vector<Future<U>>> when_all(std::vector<Future<U>> futures);
+        template<typename U> friend Future<when_any_result<U>> when_any(std::vector<Future<U>> futures);
+
+    public:
+        //! Create a future without state (not valid)
+        Future( ) noexcept = default;
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~Future( ) = default;
+
+        //! Copying not allowed for objects of this type
+        Future(Future &other) = delete;
+        //! Copying not allowed for objects of this type
+        Future& operator=(Future &other) = delete;
+
+        //! move everything to a new object
+        Future(Future &&other) noexcept = default;
+        //! move everything to a new object
+        Future& operator=(Future &&other) noexcept = default;
+
+        //! check if the future has a state (not consumed by get() or then())
+        inline bool valid( ) const noexcept;
+
+        //! check if the result is available (false if the future is not valid)
+        inline bool is_ready( ) const noexcept;
+
+        /*! wait until the result is available
+         *
+         * possible throws:
+         *      - std::future_error: no_state
+         *      - std::system_error: a system call failed
+         */
+        void wait( ) const;
+
+        /*! wait until the result is available or the time span expired
+         *
+         * attributes:
+         *      - time: maximum time to wait (CLOCK_MONOTONIC)
+         *
+         * return value: false if the time span expired
+         *
+         * possible throws:
+         *      - std::future_error    : no_state
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool wait_for(const timespec &time) const;
+
+        /*! wait until the result is available and get it (consumes the future)
+         *
+         * possible throws:
+         *      - std::future_error: no_state
+         *      - std::system_error: a system call failed
+         *      - the exception stored by the promise
+         */
+        T get( );
+
+        /*! execute function once the result is available (consumes the future)
+         *
+         * function is called with the ready Future<T>. It is executed by the thread that stores the result or, if the
+         * result is already available, immediately by the calling thread.
+         *
+         * return value: future of the return value of function
+         *
+         * possible throws:
+         *      - std::future_error: no_state
+         *      - std::bad_alloc   : out of memory
+         */
+        template<typename Function>
+        auto then(Function &&function) -> Future<decltype(function(std::declval<Future<T>>()))>;
+
+        /*! execute function by an executor once the result is available (consumes the future)
+         *
+         * The continuation is submitted to executor (any object with a method submit(std::function<void()>), e.g.
+         * ThreadPool or Scheduler) by the thread that stores the result. If submitting fails, the exception becomes
+         * the result of the returned future. The executor must exist until the continuation was submitted.
+         *
+         * return value: future of the return value of function
+         *
+         * possible throws:
+         *      - std::future_error: no_state
+         *      - std::bad_alloc   : out of memory
+         */
+        template<typename Executor, typename Function>
+        auto then(Executor &executor, Function &&function) -> Future<decltype(function(std::declval<Future<T>>()))>;
+};
+
+/*! \brief Producer of the result of a Future
+ *
+ * The result is stored with set_value() or set_exception(). If the promise is destroyed without storing a result,
+ * the future receives a std::future_error (broken_promise).
+ *
+ * template arguments:
+ *      - T: type of the result (void: no result)
+ */
+template<typename T>
+class Promise final
+{
+    private:
+        //! state shared with the future, nullptr: moved
+        std::shared_ptr<future_internal::shared_state<T>> state;
+
+        //! true if get_future() was called
+        bool future_retrieved;
+
+        //! store broken_promise if no result was stored
+        void abandon( ) noexcept;
+
+    public:
+        /*! Create a new Promise
+         *
+         * possible throws:
+         *      - std::bad_alloc: out of memory
+         */
+        Promise( );
+
+        //! Store broken_promise if no result was stored, not virtual because object is final and does not inherit
+        ~Promise( );
+
+        //! Copying not allowed for objects of this type
+        Promise(Promise &other) = delete;
+        //! Copying not allowed for objects of this type
+        Promise& operator=(Promise &other) = delete;
+
+        //! move everything to a new object
+        Promise(Promise &&other) noexcept;
+        //! move everything to a new object (the state of this promise is abandoned)
+        Promise& operator=(Promise &&other) noexcept;
+
+        /*! get the future (only once)
+         *
+         * possible throws:
+         *      - std::future_error: future_already_retrieved or no_state
+         */
+        Future<T> get_future( );
+
+        /*! store the result (constructed from args, no arguments for Promise<void>)
+         *
+         * Waiting threads are woken, the continuation of the future is executed by the calling thread.
+         *
+         * possible throws:
+         *      - std::future_error: promise_already_satisfied or no_state
+         *      - std::system_error: a system call failed
+         *      - any exception thrown by the constructor of T
+         */
+        template<typename... Args>
+        void set_value(Args&&... args);
+
+        /*! store an exception as result
+         *
+         * possible throws:
+         *      - std::future_error: promise_already_satisfied or no_state
+         *      - std::system_error: a system call failed
+         */
+        void set_exception(std::exception_ptr exception);
+};
+
+//! result of when_any
+template<typename T>
+struct when_any_result
+{
+    //! index of the first ready future
+    std::size_t index;
+
+    //! all futures passed to when_any
+    std::vector<Future<T>> futures;
+};
+
+// -------------------- Future -----------------------------------------------------------------------------------------
+
+template<typename T>
+Future<T>::Future(std::shared_ptr<future_internal::shared_state<T>> state) noexcept :
+        state(std::move(state))
+{ }
+
+template<typename T>
+void Future<T>::check_valid( ) const
+{
+    if (!state) throw std::future_error(std::future_errc::no_state);
+}
+
+template<typename T>
+inline bool Future<T>::valid( ) const noexcept
+{
+    return static_cast<bool>(state);
+}
+
+template<typename T>
+inline bool Future<T>::is_ready( ) const noexcept
+{
+    return state && state->is_ready();
+}
+
+template<typename T>
+void Future<T>::wait( ) const
+{
+    check_valid();
+    state->wait();
+}
+
+template<typename T>
+bool Future<T>::wait_for(const timespec &time) const
+{
+    check_valid();
+    return state->wait_for(time);
+}
+
+template<typename T>
+T Future<T>::get( )
+{
+    check_valid();
+    auto consumed = std::move(state);
+    consumed->wait();
+    return consumed->take();
+}
+
+template<typename T>
+template<typename Function, typename Schedule>
+auto Future<T>::chain(Function &&function, Schedule schedule) -> Future<decltype(function(std::declval<Future<T>>()))>
+{
+    typedef decltype(function(std::declval<Future<T>>())) result_t;
+
+    check_valid();
+
+    auto next = std::make_shared<future_internal::shared_state<result_t>>();
+
+    // shared: the continuation is stored in a std::function, which requires copyable objects
+    auto shared_function = std::make_shared<typename std::decay<Function>::type>(std::forward<Function>(function));
+
+    auto source = state;
+    std::function<void()> run = [source, next, shared_function]( )
+    {
+        future_internal::fulfill(*next, *shared_function, Future<T>(source));
+    };
+
+    // the continuation owns the source state until it is executed
+    source->add_continuation([next, run, schedule]( )
+    {
+        try
+        {
+            schedule(run);
+        }
+        catch (...)
+        {
+            if (!next->is_satisfied()) next->set_exception(std::current_exception());
+        }
+    });
+
+    state.reset();
+    return Future<result_t>(std::move(next));
+}
+
+template<typename T>
+template<typename Function>
+auto Future<T>::then(Function &&function) -> Future<decltype(function(std::declval<Future<T>>()))>
+{
+    return chain(std::forward<Function>(function), [](const std::function<void()> &run)
+    {   run();});
+}
+
+template<typename T>
+template<typename Executor, typename Function>
+auto Future<T>::then(Executor &executor, Function &&function) -> Future<decltype(function(std::declval<Future<T>>()))>
+{
+    Executor *executor_pointer = &executor;
+    return chain(std::forward<Function>(function), [executor_pointer](const std::function<void()> &run)
+    {   executor_pointer->submit(run);});
+}
+
+// -------------------- Promise ----------------------------------------------------------------------------------------
+
+template<typename T>
+Promise<T>::Promise( ) :
+        state(std::make_shared<future_internal::shared_state<T>>()),
+        future_retrieved(false)
+{ }
+
+template<typename T>
+Promise<T>::Promise(Promise &&other) noexcept :
+        state(std::move(other.state)),
+        future_retrieved(other.future_retrieved)
+{ }
+
+template<typename T>
+Promise<T>::~Promise( )
+{
+    abandon();
+}
+
+template<typename T>
+Promise<T>& Promise<T>::operator=(Promise &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        abandon();
+        state = std::move(other.state);
+        future_retrieved = other.future_retrieved;
+    }
+
+    return *this;
+}
+
+template<typename T>
+void Promise<T>::abandon( ) noexcept
+{
+    if (!state || state->is_satisfied()) return;
+
+    try
+    {
+        state->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+    }
+    catch (...)
+    {
+        // another thread stored a result in the meantime or waking the waiting threads failed: nothing to do
+    }
+}
+
+template<typename T>
+Future<T> Promise<T>::get_future( )
+{
+    if (!state) throw std::future_error(std::future_errc::no_state);
+    if (future_retrieved) throw std::future_error(std::future_errc::future_already_retrieved);
+
+    future_retrieved = true;
+    return Future<T>(state);
+}
+
+template<typename T>
+template<typename... Args>
+void Promise<T>::set_value(Args&&... args)
+{
+    if (!state) throw std::future_error(std::future_errc::no_state);
+    state->set_value(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void Promise<T>::set_exception(std::exception_ptr exception)
+{
+    if (!state) throw std::future_error(std::future_errc::no_state);
+    state->set_exception(exception);
+}
+
+// -------------------- Combinators ------------------------------------------------------------------------------------
+
+/*! get a future that is ready once all futures are ready
+ *
+ * The futures are consumed and returned (ready) as result. No thread is blocked while waiting.
+ *
+ * attributes:
+ *      - futures: futures to wait for (must be valid)
+ *
+ * possible throws:
+ *      - std::future_error: a future is not valid
+ *      - std::bad_alloc   : out of memory
+ */
+template<typename T>
+Future<std::vector<Future<T>>> when_all(std::vector<Future<T>> futures)
+{
+    struct context_t
+    {
+        std::vector<Future<T>> futures;
+        std::atomic<std::size_t> remaining;
+        Promise<std::vector<Future<T>>> promise;
+    };
+
+    for (const auto &future : futures)
+        future.check_valid();
+
+    auto context = std::make_shared<context_t>();
+    auto result = context->promise.get_future();
+
+    if (futures.empty())
+    {
+        context->promise.set_value(std::move(futures));
+        return result;
+    }
+
+    // the continuations of the last futures might complete the promise while the others are added
+    std::vector<std::shared_ptr<future_internal::shared_state<T>>> states;
+    states.reserve(futures.size());
+    for (const auto &future : futures)
+        states.push_back(future.state);
+
+    context->futures = std::move(futures);
+    context->remaining.store(states.size(), std::memory_order_relaxed);
+
+    for (auto &state : states)
+    {
+        state->add_continuation([context]( )
+        {
+            if (context->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                context->promise.set_value(std::move(context->futures));
+        });
+    }
+
+    return result;
+}
+
+/*! get a future that is ready once one of the futures is ready
+ *
+ * The futures are consumed and returned as result, together with the index of the first ready future.
+ * No thread is blocked while waiting. The futures that were not ready yet can be used like any other future (e.g. with
+ * then() or another when_any()).
+ *
+ * attributes:
+ *      - futures: futures to wait for (must be valid)
+ *
+ * possible throws:
+ *      - std::invalid_argument: futures is empty
+ *      - std::future_error    : a future is not valid
+ *      - std::bad_alloc       : out of memory
+ */
+template<typename T>
+Future<when_any_result<T>> when_any(std::vector<Future<T>> futures)
+{
+    struct context_t
+    {
+        std::vector<Future<T>> futures;
+        std::atomic<bool> done;
+        Promise<when_any_result<T>> promise;
+    };
+
+    if (futures.empty())
+        throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + ": No futures to wait for.");
+
+    for (const auto &future : futures)
+        future.check_valid();
+
+    auto context = std::make_shared<context_t>();
+    auto result = context->promise.get_future();
+
+    // the first ready future moves the futures to the result while the other continuations are added
+    std::vector<std::shared_ptr<future_internal::shared_state<T>>> states;
+    states.reserve(futures.size());
+    for (const auto &future : futures)
+        states.push_back(future.state);
+
+    context->futures = std::move(futures);
+    context->done.store(false, std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+        states[i]->add_continuation([context, i]( )
+        {
+            if (!context->done.exchange(true, std::memory_order_acq_rel))
+                context->promise.set_value(when_any_result<T>{i, std::move(context->futures)});
+        });
+    }
+
+    return result;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,127 @@
+/*
+ * \file Latch.hpp
+ * \brief Header file de::Koesling::Threading::Latch
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Single use countdown latch based on linux futexes
+ *
+ * Threads wait until the counter of the latch reached zero. The counter can not be increased or reset.
+ * Waiting threads spin briefly before they are suspended.
+ */
+class Latch final
+{
+    private:
+        //! remaining count (futex word)
+        std::atomic<int> count;
+
+    public:
+        /*! Create a new Latch
+         *
+         * attributes:
+         *      - count: initial value of the counter
+         *
+         * possible throws:
+         *      - std::invalid_argument: count is larger than INT_MAX
+         */
+        explicit Latch(unsigned int count);
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~Latch( ) = default;
+
+        //! Copying not allowed for objects of this type
+        Latch(Latch &other) = delete;
+        //! Copying not allowed for objects of this type
+        Latch& operator=(Latch &other) = delete;
+
+        //! move everything to a new object
+        Latch(Latch &&other) noexcept;
+
+        //! move everything to a new object
+        Latch& operator=(Latch &&other) noexcept;
+
+        /*! decrement the counter, release the waiting threads if it reaches zero
+         *
+         * attributes:
+         *      - n: value to subtract from the counter
+         *
+         * possible throws:
+         *      - std::logic_error : n is larger than the counter
+         *      - std::system_error: a system call failed
+         */
+        void count_down(unsigned int n = 1);
+
+        //! check if the counter reached zero
+        inline bool try_wait( ) const noexcept;
+
+        /*! wait until the counter reaches zero (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait( );
+
+        /*! wait until the counter reaches zero (with timeout)
+         *
+         * attributes:
+         *      - time: maximum time to wait
+         *
+         * return value:
+         *      true : the counter reached zero
+         *      false: the counter did not reach zero within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! decrement the counter and wait until it reaches zero
+         *
+         * attributes:
+         *      - n: value to subtract from the counter
+         *
+         * possible throws:
+         *      - std::logic_error : n is larger than the counter
+         *      - std::system_error: a system call failed
+         */
+        void arrive_and_wait(unsigned int n = 1);
+
+        //! get the current value of the counter
+        inline unsigned int get_count( ) const noexcept;
+};
+
+inline bool Latch::try_wait( ) const noexcept
+{
+    return count.load(std::memory_order_acquire) == 0;
+}
+
+inline unsigned int Latch::get_count( ) const noexcept
+{
+    return static_cast<unsigned int>(count.load(std::memory_order_relaxed));
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,153 @@
+/*
+ * \file Lazy.hpp
+ * \brief Header file de::Koesling::Threading::Lazy
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "Once.hpp"
+
+#include <functional>
+#include <new>
+#include <type_traits>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Lazily initialized value
+ *
+ * The value is created by the factory function on the first access. Concurrent first accesses are suspended until
+ * the value is created (see call_once). Every access after the initialization is a single atomic load (acquire).
+ *
+ * template arguments:
+ *      - T: type of the value
+ */
+template<typename T>
+class Lazy final
+{
+    public:
+        //! type of the factory function
+        typedef std::function<T()> factory_function_t;
+
+    private:
+        //! set once the value is created
+        OnceFlag flag;
+
+        //! creates the value
+        factory_function_t factory;
+
+        //! storage for the value
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        //! pointer to the value (only valid once it is created)
+        inline T* value_pointer( ) noexcept;
+
+    public:
+        /*! Create a new Lazy object (the value is not created yet)
+         *
+         * attributes:
+         *      - factory: function that creates the value
+         */
+        explicit Lazy(factory_function_t factory);
+
+        //! Destroy the value if it was created, not virtual because object is final and does not inherit
+        ~Lazy( );
+
+        //! Copying not allowed for objects of this type
+        Lazy(Lazy &other) = delete;
+        //! Copying not allowed for objects of this type
+        Lazy& operator=(Lazy &other) = delete;
+
+        //! Moving not allowed for objects of this type (other threads might access the value)
+        Lazy(Lazy &&other) = delete;
+        //! Moving not allowed for objects of this type (other threads might access the value)
+        Lazy& operator=(Lazy &&other) = delete;
+
+        /*! get the value, create it if necessary
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         *      - any exception thrown by the factory function or the constructor of T
+         */
+        T& get( );
+
+        //! get the value, create it if necessary (see get())
+        inline T& operator*( );
+
+        //! access the value, create it if necessary (see get())
+        inline T* operator->( );
+
+        //! check if the value was created
+        inline bool is_initialized( ) const noexcept;
+};
+
+template<typename T>
+Lazy<T>::Lazy(factory_function_t factory) :
+        factory(std::move(factory))
+{ }
+
+template<typename T>
+Lazy<T>::~Lazy( )
+{
+    if (flag.is_done()) value_pointer()->~T();
+}
+
+template<typename T>
+inline T* Lazy<T>::value_pointer( ) noexcept
+{
+    return reinterpret_cast<T*>(&storage);
+}
+
+template<typename T>
+T& Lazy<T>::get( )
+{
+    // fast path: single atomic load
+    if (!flag.is_done())
+    {
+        call_once(flag, [this]( )
+        {
+            new (&storage) T(factory());
+
+            // the factory is not needed anymore
+            factory = nullptr;
+        });
+    }
+
+    return *value_pointer();
+}
+
+template<typename T>
+inline T& Lazy<T>::operator*( )
+{
+    return get();
+}
+
+template<typename T>
+inline T* Lazy<T>::operator->( )
+{
+    return &get();
+}
+
+template<typename T>
+inline bool Lazy<T>::is_initialized( ) const noexcept
+{
+    return flag.is_done();
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
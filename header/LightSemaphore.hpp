@@ -0,0 +1,137 @@
+/*
+ * \file LightSemaphore.hpp
+ * \brief Header file de::Koesling::Threading::LightSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "SemaphoreCounter.hpp"
+
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Counting semaphore based on an atomic counter and linux futexes
+ *
+ * Same interface as Semaphore and the same counter (see semaphore_internal::counter): wait() spins briefly before the
+ * thread is suspended, suspended threads are served in FIFO order and post() only performs a system call if threads
+ * are actually suspended.
+ *
+ * Unlike Semaphore, the LightSemaphore does not keep track of the threads that hold it.
+ * Therefore double waits within one thread and posts from threads that do not hold the semaphore are not detected.
+ */
+class LightSemaphore final
+{
+    private:
+        //! number of available accesses and the queue of the suspended threads
+        semaphore_internal::counter count;
+
+        //! maximum value for this semaphore
+        unsigned int max_value;
+
+    public:
+        /*! Create a new LightSemaphore
+         *
+         * attributes:
+         *      - value: maximum value of this semaphore (== number of possible simultaneous accesses)
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid value (0 or larger than INT_MAX)
+         */
+        explicit LightSemaphore(unsigned int value);
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~LightSemaphore( ) = default;
+
+        //! Copying not allowed for objects of this type
+        LightSemaphore(LightSemaphore &other) = delete;
+        //! Copying not allowed for objects of this type
+        LightSemaphore& operator=(LightSemaphore &other) = delete;
+
+        //! move everything to a new object
+        LightSemaphore(LightSemaphore &&other) noexcept;
+
+        //! move everything to a new object
+        LightSemaphore& operator=(LightSemaphore &&other) noexcept;
+
+        /*! wait for this semaphore (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait();
+
+        /*! try to get this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore is currently not available
+         */
+        bool trywait() noexcept;
+
+        /*! wait for this semaphore (with timeout)
+         *
+         * attributes:
+         *      - time: maximum time to wait for this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore was not available within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! post this semaphore
+         *
+         * possible throws:
+         *      - std::logic_error : semaphore was posted more often than it was acquired
+         *      - std::system_error: a system call failed
+         */
+        void post();
+
+        //! get current value of this semaphore
+        inline unsigned int get_current_value( ) const noexcept;
+
+        //! get the number of threads waiting for this semaphore
+        inline unsigned int get_thread_queue( ) const noexcept;
+
+        //! get the maximum value of this semaphore
+        inline unsigned int get_max_value( ) const noexcept;
+};
+
+inline unsigned int LightSemaphore::get_current_value( ) const noexcept
+{
+    return max_value - count.get_value();
+}
+
+inline unsigned int LightSemaphore::get_thread_queue( ) const noexcept
+{
+    return count.get_queued();
+}
+
+inline unsigned int LightSemaphore::get_max_value( ) const noexcept
+{
+    return max_value;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,120 @@
+/*
+ * \file ManualResetEvent.hpp
+ * \brief Header file de::Koesling::Threading::ManualResetEvent
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Event that stays set until it is reset (latched event), based on linux futexes
+ *
+ * set() releases all waiting threads and all threads that wait until reset() is called.
+ * is_set() is a single atomic load and set() only performs a system call if threads are suspended.
+ */
+class ManualResetEvent final
+{
+    private:
+        //! state of the event (futex word), 0: not set, 1: set
+        std::atomic<int> state;
+
+        //! number of threads currently suspended
+        std::atomic<int> waiters;
+
+    public:
+        /*! Create a new ManualResetEvent
+         *
+         * attributes:
+         *      - initial_state: true: the event is set
+         */
+        explicit ManualResetEvent(bool initial_state = false) noexcept;
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~ManualResetEvent( ) = default;
+
+        //! Copying not allowed for objects of this type
+        ManualResetEvent(ManualResetEvent &other) = delete;
+        //! Copying not allowed for objects of this type
+        ManualResetEvent& operator=(ManualResetEvent &other) = delete;
+
+        //! move everything to a new object
+        ManualResetEvent(ManualResetEvent &&other) noexcept;
+
+        //! move everything to a new object
+        ManualResetEvent& operator=(ManualResetEvent &&other) noexcept;
+
+        /*! wait until the event is set (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait( );
+
+        /*! wait until the event is set (with timeout)
+         *
+         * attributes:
+         *      - time: maximum time to wait for the event
+         *
+         * return value:
+         *      true : the event is set
+         *      false: the event was not set within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! set the event and release all waiting threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void set( );
+
+        //! reset the event
+        inline void reset( ) noexcept;
+
+        //! check if the event is set
+        inline bool is_set( ) const noexcept;
+
+        //! get the number of threads waiting for this event
+        inline unsigned int get_thread_queue( ) const noexcept;
+};
+
+inline void ManualResetEvent::reset( ) noexcept
+{
+    state.store(0, std::memory_order_relaxed);
+}
+
+inline bool ManualResetEvent::is_set( ) const noexcept
+{
+    return state.load(std::memory_order_acquire) == 1;
+}
+
+inline unsigned int ManualResetEvent::get_thread_queue( ) const noexcept
+{
+    return static_cast<unsigned int>(waiters.load(std::memory_order_relaxed));
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
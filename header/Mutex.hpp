@@ -48,6 +48,9 @@ namespace Threading {
             //! error message stream for "non-throwable" errors
             static std::ostream* error_stream;
 
+            //! Condition::wait(Mutex&, ...) waits on the pthread_mutex directly
+            friend class Condition;
+
         public:
             //! Create a new Mutex object
             Mutex( ) noexcept;
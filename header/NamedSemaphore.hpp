@@ -0,0 +1,187 @@
+/*
+ * \file NamedSemaphore.hpp
+ * \brief Header file de::Koesling::Threading::NamedSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <semaphore.h>
+#include <sys/types.h>
+#include <ostream>
+#include <string>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Named semaphore based on POSIX semaphores (sem_open)
+ *
+ * Unrelated processes can use the same semaphore by opening it with the same name.
+ * The semaphore exists until it is removed with unlink() and all processes closed it.
+ *
+ * Since the holders of the semaphore can not be tracked across processes, double waits and posts without wait are not
+ * detected.
+ */
+class NamedSemaphore final
+{
+    public:
+        //! how to open the semaphore
+        enum open_mode_t
+        {
+            CREATE,         //!< create a new semaphore, fail if it already exists
+            OPEN,           //!< open an existing semaphore, fail if it does not exist
+            CREATE_OR_OPEN  //!< open the semaphore, create it if it does not exist
+        };
+
+    private:
+        //! actual semaphore
+        sem_t *sem;
+
+        //! name of the semaphore
+        std::string name;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+    public:
+        /*! Create or open a named semaphore
+         *
+         * attributes:
+         *      - name       : name of the semaphore (format: "/somename", see man sem_overview)
+         *      - value      : initial value of the semaphore (== number of possible simultaneous accesses),
+         *                     only used if the semaphore is created.
+         *      - mode       : see open_mode_t
+         *      - permissions: permissions of a newly created semaphore
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid value (only happens if 0 is passed)
+         *      - std::system_error    : a system call failed
+         *                               (e.g. EEXIST: mode is CREATE and semaphore exists,
+         *                                     ENOENT: mode is OPEN and semaphore does not exist)
+         */
+        NamedSemaphore(const std::string &name, unsigned int value, open_mode_t mode = CREATE_OR_OPEN,
+                mode_t permissions = 0600);
+
+        /*! Open an existing named semaphore
+         *
+         * attributes:
+         *      - name: name of the semaphore
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        explicit NamedSemaphore(const std::string &name);
+
+        //! Close the semaphore, not virtual because object is final and does not inherit
+        ~NamedSemaphore( );
+
+        //! Copying not allowed for objects of this type
+        NamedSemaphore(NamedSemaphore &other) = delete;
+        //! Copying not allowed for objects of this type
+        NamedSemaphore& operator=(NamedSemaphore &other) = delete;
+
+        //! move everything to a new object
+        NamedSemaphore(NamedSemaphore &&other) noexcept;
+
+        //! move everything to a new object
+        NamedSemaphore& operator=(NamedSemaphore &&other) noexcept;
+
+        /*! wait for this semaphore (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait();
+
+        /*! try to get this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore is currently not available
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool trywait();
+
+        /*! wait for this semaphore (with timeout)
+         *
+         * The time span is measured with CLOCK_MONOTONIC (sem_clockwait, glibc 2.30 or newer) and is not affected by
+         * changes of the system time. With older C libraries sem_timedwait (CLOCK_REALTIME) is used.
+         *
+         * attributes:
+         *      - time: maximum time to wait for this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore was not available within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! post this semaphore
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void post();
+
+        /*! get the number of currently available accesses
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        unsigned int get_value( );
+
+        /*! remove the name of this semaphore
+         *
+         * The semaphore is destroyed once all processes closed it.
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void unlink( );
+
+        /*! remove the name of a semaphore
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        static void unlink(const std::string &name);
+
+        //! get the name of the semaphore
+        inline const std::string& get_name( ) const noexcept;
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+inline const std::string& NamedSemaphore::get_name( ) const noexcept
+{
+    return name;
+}
+
+inline void NamedSemaphore::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,142 @@
+/*
+ * \file Once.hpp
+ * \brief Header file de::Koesling::Threading::OnceFlag and de::Koesling::Threading::call_once
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Flag for call_once, based on linux futexes
+ *
+ * Once the function passed to call_once completed, checking the flag is a single atomic load (acquire).
+ * Threads that call call_once while the function is executed by another thread are suspended until it completed.
+ * If the function throws an exception, the flag is not set and the next caller executes the function.
+ */
+class OnceFlag final
+{
+    private:
+        //! state of the flag
+        enum state_t : int
+        {
+            UNINITIALIZED = 0,  //!< function was not executed yet
+            RUNNING       = 1,  //!< function is executed
+            WAITING       = 2,  //!< function is executed and threads might be waiting
+            DONE          = 3   //!< function completed
+        };
+
+        //! state of the flag (futex word)
+        std::atomic<int> state;
+
+        /*! slow path: try to become the thread that executes the function
+         *
+         * Waits if another thread currently executes the function.
+         *
+         * return value:
+         *      true : the calling thread has to execute the function
+         *      false: the function completed
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool begin( );
+
+        /*! the function completed: release the waiting threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void complete( );
+
+        /*! the function failed: release the waiting threads, one of them executes the function
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void abort( );
+
+        template<typename Function, typename... Args>
+        friend void call_once(OnceFlag &flag, Function &&function, Args&&... args);
+
+    public:
+        //! Create a new OnceFlag
+        OnceFlag( ) noexcept;
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~OnceFlag( ) = default;
+
+        //! Copying not allowed for objects of this type
+        OnceFlag(OnceFlag &other) = delete;
+        //! Copying not allowed for objects of this type
+        OnceFlag& operator=(OnceFlag &other) = delete;
+
+        //! Moving not allowed for objects of this type (other threads might wait on it)
+        OnceFlag(OnceFlag &&other) = delete;
+        //! Moving not allowed for objects of this type (other threads might wait on it)
+        OnceFlag& operator=(OnceFlag &&other) = delete;
+
+        //! check if the function completed
+        inline bool is_done( ) const noexcept;
+};
+
+/*! \brief Execute a function exactly once
+ *
+ * The function is executed by exactly one of the threads calling call_once with the same flag.
+ * All threads return after the function completed.
+ *
+ * attributes:
+ *      - flag    : OnceFlag that belongs to the function
+ *      - function: callable that is executed
+ *      - args    : arguments passed to the function
+ *
+ * possible throws:
+ *      - std::system_error: a system call failed
+ *      - any exception thrown by the function (only in the calling thread that executed it)
+ */
+template<typename Function, typename... Args>
+void call_once(OnceFlag &flag, Function &&function, Args&&... args)
+{
+    // fast path: single atomic load
+    if (flag.is_done()) return;
+
+    if (!flag.begin()) return;
+
+    try
+    {
+        std::forward<Function>(function)(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        flag.abort();
+        throw;
+    }
+
+    flag.complete();
+}
+
+inline bool OnceFlag::is_done( ) const noexcept
+{
+    return state.load(std::memory_order_acquire) == DONE;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,308 @@
+/*
+ * \file Parallel.hpp
+ * \brief Header file de::Koesling::Threading::parallel_for, parallel_reduce and parallel_scan
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/* Range arguments:
+ *      The algorithms accept index ranges (integral types) and random access iterator ranges [first, last).
+ *      The element passed to the user function is the index itself for index ranges and *iterator for iterator
+ *      ranges.
+ *
+ * Grain size:
+ *      A range is split recursively into halves until a part contains at most grain elements. One half is spawned
+ *      as task (and can be stolen by idle workers), the other half is processed by the calling thread. Therefore only
+ *      as many parts are executed in parallel as there are idle workers.
+ *      grain 0 selects the grain size depending on the range size and the number of workers (8 parts per worker).
+ *      Ranges that are not larger than the grain size are processed by the calling thread without any task.
+ *
+ * Exceptions:
+ *      If the user function throws an exception, the algorithm waits until all spawned tasks completed and rethrows
+ *      the first exception.
+ */
+
+//! internal helpers of the parallel algorithms
+namespace parallel_internal {
+
+//! number of parts per worker if the grain size is selected automatically
+constexpr std::size_t PARTS_PER_WORKER = 8;
+
+//! element of an index range: the index
+template<typename Index>
+inline Index element(Index index, std::true_type) noexcept
+{
+    return index;
+}
+
+//! element of an iterator range: the referenced object
+template<typename Iterator>
+inline auto element(Iterator iterator, std::false_type) -> decltype(*iterator)
+{
+    return *iterator;
+}
+
+//! element of an index or iterator range
+template<typename Range>
+inline auto element(Range position) -> decltype(element(position, std::is_integral<Range>()))
+{
+    return element(position, std::is_integral<Range>());
+}
+
+//! number of elements in [first, last)
+template<typename Range>
+inline std::size_t distance(Range first, Range last) noexcept
+{
+    return last > first ? static_cast<std::size_t>(last - first) : 0;
+}
+
+//! position count elements after first
+template<typename Range>
+inline Range advance(Range first, std::size_t count) noexcept
+{
+    return static_cast<Range>(first + static_cast<decltype(first - first)>(count));
+}
+
+//! grain size (see description above)
+inline std::size_t grain_size(std::size_t size, std::size_t grain, const Scheduler &scheduler) noexcept
+{
+    if (grain) return grain;
+    return std::max<std::size_t>(1, size / (scheduler.get_thread_count() * PARTS_PER_WORKER));
+}
+
+/*! execute left in a new task and right in the calling thread, wait for both
+ *
+ * The task is always waited for, even if right throws an exception (left references the stack of the caller).
+ */
+template<typename Left, typename Right>
+void fork_join(Scheduler &scheduler, Left &&left, Right &&right)
+{
+    TaskGroup group(scheduler);
+    group.spawn(std::forward<Left>(left));
+
+    try
+    {
+        right();
+    }
+    catch (...)
+    {
+        try
+        {
+            group.wait();
+        }
+        catch (...)
+        {
+            // the exception of right is rethrown
+        }
+        throw;
+    }
+
+    group.wait();
+}
+
+//! recursive part of parallel_for
+template<typename Range, typename Function>
+void for_range(Scheduler &scheduler, Range first, std::size_t size, std::size_t grain, const Function &function)
+{
+    if (size > grain)
+    {
+        // spawn the upper half, continue with the lower half
+        const std::size_t half = size / 2;
+        const Range middle = advance(first, half);
+        const std::size_t upper_size = size - half;
+
+        fork_join(scheduler,
+                [&scheduler, middle, upper_size, grain, &function]( )
+                {   for_range(scheduler, middle, upper_size, grain, function);},
+                [&scheduler, first, half, grain, &function]( )
+                {   for_range(scheduler, first, half, grain, function);});
+        return;
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+        function(element(advance(first, i)));
+}
+
+//! recursive part of parallel_reduce
+template<typename T, typename Range, typename Map, typename Reduce>
+T reduce_range(Scheduler &scheduler, Range first, std::size_t size, std::size_t grain, const T &identity,
+        const Map &map, const Reduce &reduce)
+{
+    if (size > grain)
+    {
+        const std::size_t half = size / 2;
+        const Range middle = advance(first, half);
+        const std::size_t upper_size = size - half;
+
+        T lower = identity;
+        T upper = identity;
+        fork_join(scheduler,
+                [&]( )
+                {   upper = reduce_range(scheduler, middle, upper_size, grain, identity, map, reduce);},
+                [&]( )
+                {   lower = reduce_range(scheduler, first, half, grain, identity, map, reduce);});
+
+        // lower part first: reduce must be associative, but not commutative
+        return reduce(lower, upper);
+    }
+
+    T result = identity;
+    for (std::size_t i = 0; i < size; ++i)
+        result = reduce(result, map(element(advance(first, i))));
+    return result;
+}
+
+} /* namespace parallel_internal */
+
+/*! execute function for every element of [first, last)
+ *
+ * The order in which the elements are processed is unspecified.
+ *
+ * attributes:
+ *      - first, last: index range or random access iterator range
+ *      - function   : called with every element (see range arguments above)
+ *      - grain      : maximum number of elements that are processed by one task, 0: automatic
+ *      - scheduler  : scheduler that executes the tasks
+ *
+ * possible throws:
+ *      - std::bad_alloc   : out of memory
+ *      - any exception thrown by function
+ */
+template<typename Range, typename Function>
+void parallel_for(Range first, Range last, const Function &function, std::size_t grain = 0,
+        Scheduler &scheduler = Scheduler::get_default( ))
+{
+    const std::size_t size = parallel_internal::distance(first, last);
+    parallel_internal::for_range(scheduler, first, size, parallel_internal::grain_size(size, grain, scheduler),
+            function);
+}
+
+/*! combine the mapped elements of [first, last)
+ *
+ * Computes reduce(...reduce(reduce(identity, map(e0)), map(e1))..., map(eN)). The elements are combined in parallel,
+ * therefore reduce must be associative and identity must be the identity element of reduce. The order of the
+ * elements is preserved, reduce does not need to be commutative.
+ *
+ * attributes:
+ *      - first, last: index range or random access iterator range
+ *      - identity   : identity element of reduce (result for empty ranges)
+ *      - map        : converts an element (see range arguments above) to T
+ *      - reduce     : combines two values of type T
+ *      - grain      : maximum number of elements that are processed by one task, 0: automatic
+ *      - scheduler  : scheduler that executes the tasks
+ *
+ * return value: combined value
+ *
+ * possible throws:
+ *      - std::bad_alloc   : out of memory
+ *      - any exception thrown by map or reduce
+ */
+template<typename T, typename Range, typename Map, typename Reduce>
+T parallel_reduce(Range first, Range last, const T &identity, const Map &map, const Reduce &reduce,
+        std::size_t grain = 0, Scheduler &scheduler = Scheduler::get_default( ))
+{
+    const std::size_t size = parallel_internal::distance(first, last);
+    return parallel_internal::reduce_range(scheduler, first, size,
+            parallel_internal::grain_size(size, grain, scheduler), identity, map, reduce);
+}
+
+/*! inclusive prefix scan of [first, last)
+ *
+ * output[i] = op(...op(op(identity, e0), e1)..., ei)
+ *
+ * The range is divided into blocks. The sum of every block is computed in parallel, the prefix of the block sums is
+ * computed sequentially and finally every block is scanned in parallel, starting with the prefix of the preceding
+ * blocks. Therefore op is called up to twice per element and must be associative. output may be equal to first for
+ * iterator ranges (in place scan).
+ *
+ * attributes:
+ *      - first, last: index range or random access iterator range
+ *      - output     : random access iterator to the first element of the result
+ *      - identity   : identity element of op
+ *      - op         : combines a value of type T with an element (see range arguments above) or with another T
+ *      - grain      : minimum number of elements of a block, 0: automatic
+ *      - scheduler  : scheduler that executes the tasks
+ *
+ * possible throws:
+ *      - std::bad_alloc   : out of memory
+ *      - any exception thrown by op
+ */
+template<typename T, typename Range, typename OutputIterator, typename Operation>
+void parallel_scan(Range first, Range last, OutputIterator output, const T &identity, const Operation &op,
+        std::size_t grain = 0, Scheduler &scheduler = Scheduler::get_default( ))
+{
+    const std::size_t size = parallel_internal::distance(first, last);
+    if (!size) return;
+
+    grain = parallel_internal::grain_size(size, grain, scheduler);
+    const std::size_t block_count = (size + grain - 1) / grain;
+
+    // scan a block, starting with prefix, store the results if store is true
+    auto scan_block = [&](std::size_t block, T prefix, bool store)
+    {
+        const std::size_t begin = block * grain;
+        const std::size_t end = std::min(size, begin + grain);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            prefix = op(prefix, parallel_internal::element(parallel_internal::advance(first, i)));
+            if (store) *parallel_internal::advance(output, i) = prefix;
+        }
+        return prefix;
+    };
+
+    if (block_count == 1 || scheduler.get_thread_count() == 1)
+    {
+        // sequential scan (block 0 covers the whole range if grain is set to size)
+        grain = size;
+        scan_block(0, identity, true);
+        return;
+    }
+
+    // the blocks are written concurrently: every value must be a separate object (std::vector<bool> packs them)
+    struct block_prefix_t
+    {
+        T value;
+    };
+
+    // pass 1: sum of every block (except the last one, it is not needed by any other block)
+    std::vector<block_prefix_t> prefix(block_count, block_prefix_t{identity});
+    parallel_for(std::size_t(0), block_count - 1, [&](std::size_t block)
+    {   prefix[block + 1].value = scan_block(block, identity, false);}, 1, scheduler);
+
+    // prefix of the preceding blocks
+    for (std::size_t block = 2; block < block_count; ++block)
+        prefix[block].value = op(prefix[block - 1].value, prefix[block].value);
+
+    // pass 2: scan every block starting with its prefix
+    parallel_for(std::size_t(0), block_count, [&](std::size_t block)
+    {   scan_block(block, prefix[block].value, true);}, 1, scheduler);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,255 @@
+/*
+ * \file Scheduler.hpp
+ * \brief Header file de::Koesling::Threading::Scheduler and de::Koesling::Threading::TaskGroup
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "EventCount.hpp"
+#include "Mutex.hpp"
+#include "Thread.hpp"
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+class TaskGroup;
+
+/*! \brief Work-stealing task scheduler
+ *
+ * Each worker thread owns a deque of tasks (Chase-Lev). Tasks spawned by a worker are pushed to its own deque and
+ * executed in LIFO order by the worker, which keeps the working set of recursive (fork-join) workloads small.
+ * Idle workers steal the oldest tasks from the deques of randomly selected workers. Tasks that are submitted by
+ * threads outside of the scheduler are added to a shared queue. Workers without tasks are suspended (EventCount).
+ *
+ * Use TaskGroup to spawn tasks and wait for their completion.
+ */
+class Scheduler final
+{
+    public:
+        //! type of the tasks
+        typedef std::function<void()> task_function_t;
+
+    private:
+        //! a task
+        struct task_t;
+
+        //! per worker data (deque, random number generator)
+        struct worker_t;
+
+        //! data of the worker threads
+        std::unique_ptr<worker_t[]> worker_data;
+
+        //! number of worker threads
+        std::size_t thread_count;
+
+        //! worker threads
+        std::vector<Thread> workers;
+
+        //! protects the queue of submitted tasks
+        Mutex injection_mutex;
+
+        //! tasks submitted by threads outside of the scheduler
+        std::deque<task_t*> injection_queue;
+
+        //! number of tasks in injection_queue (checked without locking the mutex)
+        std::atomic<std::size_t> injection_count;
+
+        //! idle workers are suspended here
+        EventCount idle_workers;
+
+        //! true: the workers terminate once there are no more tasks
+        std::atomic<bool> stopping;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+        //! worker data of the calling thread, nullptr: not a worker thread
+        static thread_local worker_t *this_worker;
+
+        //! main loop of a worker thread
+        void worker(std::size_t index);
+
+        //! add a task (to the deque of the calling worker or to the injection queue)
+        void schedule(task_t *task);
+
+        //! find a task for a worker (own deque, injection queue, steal), nullptr: no task
+        task_t* find_task(worker_t &worker);
+
+        //! take a task from the injection queue, nullptr: empty
+        task_t* take_injected( );
+
+        //! execute and delete a task
+        void run(task_t *task) noexcept;
+
+        //! worker data of the calling thread if it is a worker of this scheduler, otherwise nullptr
+        worker_t* current_worker( ) const noexcept;
+
+        friend class TaskGroup;
+
+    public:
+        /*! Create a new Scheduler and start the worker threads
+         *
+         * attributes:
+         *      - thread_count: number of worker threads, 0: number of online processors
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        explicit Scheduler(unsigned int thread_count = 0);
+
+        /*! Execute the remaining tasks and join the worker threads
+         *
+         * Must not be called by a task of this scheduler.
+         * not virtual because object is final and does not inherit
+         */
+        ~Scheduler( );
+
+        //! Copying not allowed for objects of this type
+        Scheduler(Scheduler &other) = delete;
+        //! Copying not allowed for objects of this type
+        Scheduler& operator=(Scheduler &other) = delete;
+
+        //! Moving not allowed, the worker threads reference the scheduler
+        Scheduler(Scheduler &&other) = delete;
+        //! Moving not allowed, the worker threads reference the scheduler
+        Scheduler& operator=(Scheduler &&other) = delete;
+
+        /*! submit a task that is not part of a TaskGroup (fire and forget)
+         *
+         * An exception thrown by the task is written to the error stream.
+         *
+         * possible throws:
+         *      - std::invalid_argument: task is empty
+         *      - std::bad_alloc       : out of memory
+         */
+        void submit(task_function_t task);
+
+        /*! get the shared default scheduler (one worker per online processor)
+         *
+         * The scheduler is created on the first call and destroyed at program exit.
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed (first call only)
+         */
+        static Scheduler& get_default( );
+
+        //! get the number of worker threads
+        inline std::size_t get_thread_count( ) const noexcept;
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+/*! \brief Group of tasks that are executed by a Scheduler
+ *
+ * spawn() adds tasks to the group, wait() waits until all tasks of the group completed. Tasks may spawn further tasks
+ * into the same group (recursive fork-join). If wait() is called by a worker of the scheduler, the worker executes
+ * other tasks while it waits.
+ *
+ * If tasks throw exceptions, the first exception is rethrown by wait().
+ */
+class TaskGroup final
+{
+    private:
+        //! scheduler that executes the tasks
+        Scheduler &scheduler;
+
+        //! set in pending if a thread is suspended in wait()
+        static constexpr int WAITER_FLAG = 1 << 30;
+
+        /*! number of unfinished tasks (futex word)
+         *
+         * WAITER_FLAG is set if a thread is suspended in wait(). The counter and the flag share one word, so the
+         * thread that completes the last task does not access the group after the counter reached zero (except for
+         * the futex wake).
+         */
+        std::atomic<int> pending;
+
+        //! true: exception contains the first exception thrown by a task
+        std::atomic<bool> failed;
+
+        //! first exception thrown by a task
+        std::exception_ptr exception;
+
+        //! a task of this group completed (exception: exception thrown by the task or nullptr)
+        void task_done(std::exception_ptr task_exception) noexcept;
+
+        //! wait until all tasks completed, without rethrowing exceptions
+        void wait_pending( );
+
+        friend class Scheduler;
+
+    public:
+        /*! Create a new TaskGroup
+         *
+         * attributes:
+         *      - scheduler: scheduler that executes the tasks
+         */
+        explicit TaskGroup(Scheduler &scheduler) noexcept;
+
+        //! Wait for the tasks of the group, not virtual because object is final and does not inherit
+        ~TaskGroup( );
+
+        //! Copying not allowed for objects of this type
+        TaskGroup(TaskGroup &other) = delete;
+        //! Copying not allowed for objects of this type
+        TaskGroup& operator=(TaskGroup &other) = delete;
+
+        //! Moving not allowed, the tasks reference the group
+        TaskGroup(TaskGroup &&other) = delete;
+        //! Moving not allowed, the tasks reference the group
+        TaskGroup& operator=(TaskGroup &&other) = delete;
+
+        /*! add a task to the group
+         *
+         * possible throws:
+         *      - std::invalid_argument: task is empty
+         *      - std::bad_alloc       : out of memory
+         */
+        void spawn(Scheduler::task_function_t task);
+
+        /*! wait until all tasks of the group completed
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         *      - the first exception thrown by a task of the group
+         */
+        void wait( );
+};
+
+inline std::size_t Scheduler::get_thread_count( ) const noexcept
+{
+    return thread_count;
+}
+
+inline void Scheduler::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -14,45 +14,67 @@
 
 #pragma once
 
-#include <semaphore.h>
+#include "SemaphoreCounter.hpp"
+#include "StopToken.hpp"
+
+#include <ctime>
 #include <pthread.h>
 #include <unordered_map>
+#include <ostream>
+#include <atomic>
 
 namespace de {
 namespace Koesling {
 namespace Threading {
 
-/* \brief Semaphore based on POSIX semaphores
- *
- * POSIX semaphores allow processes and threads to synchronize their actions.
+/* \brief Counting semaphore based on linux futexes
  *
  * A  semaphore  is  an integer whose value is never allowed to fall below zero.
- * Two operations can be performed on semaphores: increment the semaphore value by one (sem_post(3));
- * and decrement the semaphore value by one (sem_wait(3)).
- * If the  value  of  a  semaphore is currently zero, then a sem_wait(3) operation will block until the value becomes
- * greater than zero.
+ * Two operations can be performed on semaphores: increment the semaphore value (post);
+ * and decrement the semaphore value (wait).
+ * If the value of a semaphore is currently lower than the requested number of accesses, then a wait operation will
+ * block until the value is large enough.
+ *
+ * The value is kept in an atomic counter (see semaphore_internal::counter, shared with LightSemaphore). n accesses are
+ * acquired with a single compare and swap (all or nothing), so no thread ever holds a part of the requested accesses.
+ * Suspended threads are served in FIFO order and threads that do not wait can not take the accesses the first
+ * suspended thread needs, so wait(n) with a large n is not starved by threads that acquire single accesses.
+ * post(n) increments the counter once and performs a system call only if threads are suspended.
  */
 class Semaphore final
 {
+    public:
+        //! state of the semaphore at one point in time
+        struct snapshot_t
+        {
+            unsigned int max_value;         //!< maximum value of the semaphore
+            unsigned int current_value;     //!< number of accesses currently held
+            unsigned int available;         //!< number of accesses currently available (max_value - current_value)
+            unsigned int thread_queue;      //!< number of threads currently waiting for the semaphore
+        };
+
     private:
-        //! actual semaphore
-        sem_t sem;
+        //! number of available accesses and the queue of the threads waiting in wait/timedwait
+        semaphore_internal::counter value;
+
+        //! map of all known threads (object scope), number of accesses held by the thread
+        std::unordered_map<pthread_t, unsigned int> locking_threads;
 
-        //! map of all known threads (object scope), true if thread is locking this semaphore
-        std::unordered_map<pthread_t, bool> locking_threads;
+        //! protects locking_threads
+        pthread_mutex_t locking_threads_mutex;
 
         //! maximum value for this semaphore
         unsigned int max_value;
 
-        //! current value for this semaphore
-        volatile unsigned int current_value;
-
-        //! number of threads currently waiting for this semaphore
-        volatile unsigned int thread_queue;
-
         //! error message stream for "non-throwable" errors
         static std::ostream* error_stream;
 
+        //! verify the number of accesses passed to wait/trywait/timedwait
+        void verify_access_count(unsigned int n) const;
+
+        //! store that the calling thread acquired n accesses
+        void add_locking_thread(unsigned int n);
+
     public:
         /*! Create a new Semaphore
          *
@@ -60,8 +82,7 @@ class Semaphore final
          *      - value: maximum value of this semaphore (== number of possible simultaneous accesses)
          *
          * possible throws:
-         *      - std::invalid_argument: invalid value (only happens if 0 is passed)
-         *      - std::system_error    : a system call failed
+         *      - std::invalid_argument: invalid value (0 or larger than INT_MAX)
          */
         explicit Semaphore(unsigned int value);
 
@@ -80,24 +101,52 @@ class Semaphore final
         Semaphore& operator=(Semaphore &&other) noexcept;
 
         /*! wait for this semaphore (unlimited)
+         *
+         * A thread may hold multiple accesses of the semaphore at the same time.
+         *
+         * attributes:
+         *      - n: number of accesses to acquire (all or nothing)
          *
          * possible throws:
-         *      - std::logic_error : double wait within one thread
-         *      - std::system_error: a system call failed
+         *      - std::invalid_argument: n is 0 or larger than the maximum value
+         *      - std::system_error    : a system call failed
+         */
+        void wait(unsigned int n = 1);
+
+        /*! wait for this semaphore until it is available or a stop is requested
+         *
+         * A stop request (see StopSource) interrupts the wait, the thread that requests the stop does not need to know
+         * the semaphore. The thread is queued like the threads in wait(unsigned int): post() hands the accesses to the
+         * queued threads in FIFO order and a stop request only wakes the threads that wait with its token.
+         *
+         * attributes:
+         *      - token: stop token
+         *      - n    : number of accesses to acquire (all or nothing)
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: a stop was requested (no access acquired)
+         *
+         * possible throws:
+         *      - std::invalid_argument: n is 0 or larger than the maximum value
+         *      - std::system_error    : a system call failed
          */
-        void wait();
+        bool wait(const StopToken &token, unsigned int n = 1);
 
         /*! try to get this semaphore
+         *
+         * attributes:
+         *      - n: number of accesses to acquire (all or nothing)
          *
          * return value:
          *      true : could get this semaphore
          *      false: this semaphore is currently not available
          *
          * possible throws:
-         *      - std::logic_error : double wait within one thread
-         *      - std::system_error: a system call failed
+         *      - std::invalid_argument: n is 0 or larger than the maximum value
+         *      - std::system_error    : a system call failed
          */
-        bool trywait();
+        bool trywait(unsigned int n = 1);
 
         /*! wait for this semaphore (with timeout)
          *
@@ -109,23 +158,43 @@ class Semaphore final
          *      false: this semaphore was not available within the specified time span
          *
          * possible throws:
-         *      - std::logic_error     : double wait within one thread
          *      - std::invalid_argument: time span is invalid
          *      - std::system_error    : a system call failed
          *
          */
         bool timedwait(const timespec &time);
 
+        /*! wait for n accesses of this semaphore (with timeout)
+         *
+         * attributes:
+         *      - n   : number of accesses to acquire (all or nothing)
+         *      - time: maximum time to wait for this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore was not available within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: n is 0 or larger than the maximum value or time span is invalid
+         *      - std::system_error    : a system call failed
+         *
+         */
+        bool timedwait(unsigned int n, const timespec &time);
+
         /*! post this semaphore
+         *
+         * attributes:
+         *      - n: number of accesses to release
          *
          * possible throws:
-         *      - std::logic_error : thread does not lock this semaphore
-         *      - std::system_error: a system call failed
+         *      - std::invalid_argument: n is 0
+         *      - std::logic_error     : thread does not hold n accesses of this semaphore
+         *      - std::system_error    : a system call failed
          */
-        void post();
+        void post(unsigned int n = 1);
 
-        //! get current value of this semaphore
-        inline unsigned int get_current_value( ) const noexcept;
+        //! get current value of this semaphore (number of accesses currently held)
+        unsigned int get_current_value( ) const noexcept;
 
         //! get the number of threads waiting for this semaphore
         inline unsigned int get_thread_queue( ) const noexcept;
@@ -133,18 +202,20 @@ class Semaphore final
         //! get the maximum value of this semaphore
         inline unsigned int get_max_value( ) const noexcept;
 
+        /*! \brief get the state of the semaphore
+         *
+         * current_value and available are derived from the same read of the semaphore value and therefore always add
+         * up to max_value.
+         */
+        snapshot_t get_snapshot( ) const noexcept;
+
         //! Set stream for error output for "non-throwable" errors
         inline static void set_error_stream(std::ostream& stream) noexcept;
 };
 
-inline unsigned int Semaphore::get_current_value( ) const noexcept
-{
-    return current_value;
-}
-
 inline unsigned int Semaphore::get_thread_queue( ) const noexcept
 {
-    return thread_queue;
+    return value.get_queued();
 }
 
 inline unsigned int Semaphore::get_max_value( ) const noexcept
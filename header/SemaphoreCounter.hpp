@@ -0,0 +1,199 @@
+/*
+ * \file SemaphoreCounter.hpp
+ * \brief Header file de::Koesling::Threading::semaphore_internal::counter
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "StopToken.hpp"
+
+#include <atomic>
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+//! internal types of Semaphore and LightSemaphore
+namespace semaphore_internal {
+
+/*! \brief Value of a counting semaphore based on an atomic counter and linux futexes
+ *
+ * The number of available accesses is kept in an atomic counter, n accesses are acquired with a single compare and
+ * swap (all or nothing). A thread that can not acquire its accesses spins briefly and is then appended to a FIFO queue
+ * of suspended threads. Released accesses are handed directly to the first queued thread as soon as there are enough
+ * of them, each queued thread sleeps on its own futex word and is woken individually.
+ *
+ * Threads that are not queued may still acquire accesses without waiting, but never the accesses that the first
+ * queued thread needs. So a thread that waits for many accesses is not starved by threads that constantly acquire
+ * and release a few: the released accesses accumulate until it can continue.
+ *
+ * A queued thread can wait with a StopToken: a stop request removes only this thread from the queue and wakes it.
+ *
+ * release() only performs a system call if threads are queued.
+ */
+class counter final
+{
+    private:
+        //! queued thread (lives on the stack of the thread)
+        struct waiter_t
+        {
+            //! futex word, see waiter_state_t
+            std::atomic<int> state;
+            //! number of requested accesses
+            int count;
+            //! previous queued thread
+            waiter_t *prev;
+            //! next queued thread
+            waiter_t *next;
+        };
+
+        //! state of a queued thread
+        enum waiter_state_t : int
+        {
+            QUEUED  = 0,    //!< waiting for the accesses
+            GRANTED = 1,    //!< the accesses were handed to the thread, it is no longer queued
+            STOPPED = 2     //!< a stop was requested, the thread is no longer queued
+        };
+
+        //! number of available accesses
+        std::atomic<int> value;
+
+        //! number of accesses requested by the first queued thread (0: no thread queued)
+        std::atomic<int> reserved;
+
+        //! number of queued threads (release() only performs a system call if there are any)
+        std::atomic<unsigned int> queued;
+
+        //! protects the queue (futex word, see futex_lock)
+        std::atomic<int> lock_word;
+
+        //! first queued thread
+        waiter_t *head;
+
+        //! last queued thread
+        waiter_t *tail;
+
+        //! hand the available accesses to the queued threads in FIFO order (lock must be held)
+        void grant( );
+
+        //! remove a thread from the queue (lock must be held)
+        void unlink(waiter_t &waiter) noexcept;
+
+        /*! append the calling thread to the queue and wait until it got its accesses
+         *
+         * return value: false, if the accesses were not available within the specified time or a stop was requested
+         */
+        bool suspend(int count, const timespec *deadline, const StopToken &token);
+
+        //! remove a queued thread after a stop request and wake it
+        void stop(waiter_t &waiter) noexcept;
+
+        /*! remove the calling thread from the queue after it waited (lock must not be held)
+         *
+         * attributes:
+         *      - waiter   : the queue entry of the calling thread
+         *      - give_back: true: return the accesses if they were granted (the wait failed)
+         *
+         * return value: true, if the accesses were granted and are kept by the calling thread
+         */
+        bool leave(waiter_t &waiter, bool give_back);
+
+    public:
+        //! Create a new counter with value available accesses (0 .. INT_MAX)
+        explicit counter(int value) noexcept;
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~counter( ) = default;
+
+        //! Copying not allowed for objects of this type
+        counter(counter &other) = delete;
+        //! Copying not allowed for objects of this type
+        counter& operator=(counter &other) = delete;
+
+        //! move the value to a new object (no thread must be queued)
+        counter(counter &&other) noexcept;
+
+        //! move the value to a new object (no thread must be queued)
+        counter& operator=(counter &&other) noexcept;
+
+        //! decrement the counter by n if possible (all or nothing) without blocking
+        inline bool try_acquire(unsigned int n) noexcept;
+
+        /*! decrement the counter by n (all or nothing), block until the accesses are available
+         *
+         * attributes:
+         *      - n       : number of accesses
+         *      - deadline: absolute timeout (CLOCK_MONOTONIC), nullptr: no timeout
+         *      - token   : a stop request interrupts the wait (default: no stop token)
+         *
+         * return value: false, if the accesses were not available within the specified time or a stop was requested
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool acquire(unsigned int n, const timespec *deadline, const StopToken &token = StopToken( ));
+
+        /*! increment the counter by n and hand the accesses to the queued threads
+         *
+         * attributes:
+         *      - n    : number of accesses
+         *      - limit: the counter must not exceed this value
+         *
+         * return value: false, if the counter would exceed limit (the counter is not changed)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool release(unsigned int n, unsigned int limit);
+
+        //! get the number of available accesses
+        inline unsigned int get_value( ) const noexcept;
+
+        //! get the number of queued threads
+        inline unsigned int get_queued( ) const noexcept;
+};
+
+inline bool counter::try_acquire(unsigned int n) noexcept
+{
+    const int count = static_cast<int>(n);
+    int available = value.load(std::memory_order_seq_cst);
+
+    // the accesses requested by the first queued thread are not taken
+    while (available - reserved.load(std::memory_order_seq_cst) >= count)
+    {
+        if (value.compare_exchange_weak(available, available - count, std::memory_order_acquire,
+                std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+inline unsigned int counter::get_value( ) const noexcept
+{
+    return static_cast<unsigned int>(value.load(std::memory_order_relaxed));
+}
+
+inline unsigned int counter::get_queued( ) const noexcept
+{
+    return queued.load(std::memory_order_relaxed);
+}
+
+} /* namespace semaphore_internal */
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
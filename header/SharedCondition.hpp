@@ -0,0 +1,242 @@
+/*
+ * \file SharedCondition.hpp
+ * \brief Header file de::Koesling::Threading::SharedCondition
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <ctime>
+#include <ostream>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Process-shared condition variable and mutex based on pthread_cond and pthread_mutex
+ *
+ * The object is intended to be constructed (placement new) in shared memory (e.g. shm_open + mmap or
+ * mmap with MAP_SHARED | MAP_ANONYMOUS before fork).
+ * All processes that have access to the memory can use the condition. Waiting and signaling costs a futex system
+ * call only, no pipe or socket is required.
+ * It must be constructed and destroyed by exactly one process.
+ *
+ * The condition contains its own mutex that protects the shared state. The mutex is checked for errors
+ * (PTHREAD_MUTEX_ERRORCHECK), since the owner of the mutex can not be tracked across processes.
+ * Timed waits use CLOCK_MONOTONIC and are not affected by changes of the system time.
+ *
+ * The mutex is robust (PTHREAD_MUTEX_ROBUST): if a process (or thread) terminates while it holds the mutex, the next
+ * thread that locks it (lock(), trylock() or one of the waits) takes it over instead of blocking forever. The mutex is
+ * made consistent again and owner_died() returns true, because the terminated owner might have left the shared state
+ * inconsistent.
+ *
+ * The object contains no pointers and therefore can be mapped to different addresses in different processes.
+ */
+class SharedCondition final
+{
+    private:
+        //! mutex that protects the shared state (process-shared)
+        pthread_mutex_t mutex;
+
+        //! actual condition variable (process-shared, CLOCK_MONOTONIC)
+        pthread_cond_t condition;
+
+        //! true: the mutex was taken over from a terminated owner, reset by owner_died() (protected by mutex)
+        bool recovered;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+        /*! wait once for the condition
+         *
+         * attributes:
+         *      - timeout_time: absolute time point (CLOCK_MONOTONIC), nullptr: no timeout
+         *
+         * return value: false if the timeout expired
+         */
+        bool wait_once(const timespec *timeout_time);
+
+        //! Calculate the absolute time point (CLOCK_MONOTONIC) for a timeout of time span time
+        static timespec timeout(const timespec &time);
+
+        /*! make the mutex consistent if its previous owner terminated (result EOWNERDEAD, mutex is held)
+         *
+         * return value: result, 0 if the mutex was made consistent
+         */
+        int recover(int result);
+
+    public:
+        /*! Create a new SharedCondition
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        SharedCondition( );
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~SharedCondition( );
+
+        //! Copying not allowed for objects of this type
+        SharedCondition(SharedCondition &other) = delete;
+        //! Copying not allowed for objects of this type
+        SharedCondition& operator=(SharedCondition &other) = delete;
+
+        //! Moving not allowed, the object is used by other processes
+        SharedCondition(SharedCondition &&other) = delete;
+        //! Moving not allowed, the object is used by other processes
+        SharedCondition& operator=(SharedCondition &&other) = delete;
+
+        /*! lock the mutex of the condition
+         *
+         * If the previous owner terminated while it held the mutex, the mutex is taken over (see owner_died()).
+         *
+         * possible throws:
+         *      - std::logic_error : the mutex is already locked by the calling thread
+         *      - std::system_error: a system call failed
+         */
+        void lock( );
+
+        /*! try to lock the mutex of the condition
+         *
+         * return value:
+         *      true : mutex is locked
+         *      false: mutex is already locked (by another thread or the calling thread)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool trylock( );
+
+        /*! check whether the mutex was taken over from a terminated owner
+         *
+         * Must be called with the mutex locked. Returns true once after lock(), trylock() or a wait took over the
+         * mutex from a process or thread that terminated while it held the mutex. The shared state protected by the
+         * mutex might be inconsistent and has to be repaired by the caller.
+         */
+        bool owner_died( ) noexcept;
+
+        /*! unlock the mutex of the condition
+         *
+         * possible throws:
+         *      - std::logic_error : the mutex is not locked by the calling thread
+         *      - std::system_error: a system call failed
+         */
+        void unlock( );
+
+        /*! wait for the condition to be signaled
+         *
+         * The mutex must be locked by the calling thread. It is released while the thread is suspended and locked
+         * again before the method returns. Spurious wakeups are possible, the shared state must be checked again.
+         *
+         * possible throws:
+         *      - std::logic_error : the mutex is not locked by the calling thread
+         *      - std::system_error: a system call failed
+         */
+        void wait( );
+
+        /*! wait for the condition to be signaled (with timeout)
+         *
+         * see wait()
+         *
+         * attributes:
+         *      - time: maximum time to wait
+         *
+         * return value: false if the timeout expired
+         *
+         * possible throws:
+         *      - std::logic_error     : the mutex is not locked by the calling thread
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! wait until the predicate is satisfied
+         *
+         * attributes:
+         *      - predicate: callable that returns true if the thread shall continue.
+         *                   Only called while the mutex is locked.
+         *
+         * possible throws:
+         *      - std::logic_error : the mutex is not locked by the calling thread
+         *      - std::system_error: a system call failed
+         */
+        template<typename Predicate>
+        void wait(Predicate predicate);
+
+        /*! wait until the predicate is satisfied or the time span expired
+         *
+         * attributes:
+         *      - time     : maximum time to wait
+         *      - predicate: callable that returns true if the thread shall continue.
+         *                   Only called while the mutex is locked.
+         *
+         * return value: result of the last evaluation of predicate
+         *
+         * possible throws:
+         *      - std::logic_error     : the mutex is not locked by the calling thread
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        template<typename Predicate>
+        bool wait_for(const timespec &time, Predicate predicate);
+
+        /*! restart one of the waiting threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void signal( );
+
+        /*! restart all waiting threads
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void broadcast( );
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+template<typename Predicate>
+void SharedCondition::wait(Predicate predicate)
+{
+    while (!predicate( ))
+        wait_once(nullptr);
+}
+
+template<typename Predicate>
+bool SharedCondition::wait_for(const timespec &time, Predicate predicate)
+{
+    const timespec timeout_time = timeout(time);
+
+    while (!predicate( ))
+    {
+        if (!wait_once(&timeout_time)) return predicate( );
+    }
+
+    return true;
+}
+
+inline void SharedCondition::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -0,0 +1,145 @@
+/*
+ * \file SharedSemaphore.hpp
+ * \brief Header file de::Koesling::Threading::SharedSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <semaphore.h>
+#include <ostream>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Process-shared semaphore based on POSIX semaphores
+ *
+ * The object is intended to be constructed (placement new) in shared memory (e.g. shm_open + mmap or
+ * mmap with MAP_SHARED | MAP_ANONYMOUS before fork).
+ * All processes that have access to the memory can use the semaphore.
+ * It must be constructed and destroyed by exactly one process.
+ *
+ * The object contains no pointers and therefore can be mapped to different addresses in different processes.
+ * Since the holders of the semaphore can not be tracked across processes, double waits and posts without wait are not
+ * detected.
+ */
+class SharedSemaphore final
+{
+    private:
+        //! actual semaphore (process-shared)
+        sem_t sem;
+
+        //! maximum value for this semaphore
+        unsigned int max_value;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+    public:
+        /*! Create a new SharedSemaphore
+         *
+         * attributes:
+         *      - value: maximum value of this semaphore (== number of possible simultaneous accesses)
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid value (only happens if 0 is passed)
+         *      - std::system_error    : a system call failed
+         */
+        explicit SharedSemaphore(unsigned int value);
+
+        //! Destroy Object, not virtual because object is final and does not inherit
+        ~SharedSemaphore( );
+
+        //! Copying not allowed for objects of this type
+        SharedSemaphore(SharedSemaphore &other) = delete;
+        //! Copying not allowed for objects of this type
+        SharedSemaphore& operator=(SharedSemaphore &other) = delete;
+
+        //! Moving not allowed, the object is used by other processes
+        SharedSemaphore(SharedSemaphore &&other) = delete;
+        //! Moving not allowed, the object is used by other processes
+        SharedSemaphore& operator=(SharedSemaphore &&other) = delete;
+
+        /*! wait for this semaphore (unlimited)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void wait();
+
+        /*! try to get this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore is currently not available
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        bool trywait();
+
+        /*! wait for this semaphore (with timeout)
+         *
+         * The time span is measured with CLOCK_MONOTONIC (sem_clockwait, glibc 2.30 or newer) and is not affected by
+         * changes of the system time. With older C libraries sem_timedwait (CLOCK_REALTIME) is used.
+         *
+         * attributes:
+         *      - time: maximum time to wait for this semaphore
+         *
+         * return value:
+         *      true : could get this semaphore
+         *      false: this semaphore was not available within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: time span is invalid
+         *      - std::system_error    : a system call failed
+         */
+        bool timedwait(const timespec &time);
+
+        /*! post this semaphore
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void post();
+
+        /*! get the number of currently available accesses
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        unsigned int get_value( );
+
+        //! get the maximum value of this semaphore
+        inline unsigned int get_max_value( ) const noexcept;
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+inline unsigned int SharedSemaphore::get_max_value( ) const noexcept
+{
+    return max_value;
+}
+
+inline void SharedSemaphore::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
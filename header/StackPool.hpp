@@ -0,0 +1,146 @@
+/*
+ * \file StackPool.hpp
+ * \brief Header file de::Koesling::Threading::StackPool
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "Mutex.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Pool of thread stacks
+ *
+ * Stacks are allocated with mmap and protected by a guard area (PROT_NONE) below the stack, so a stack overflow
+ * causes a segmentation fault instead of overwriting other memory. Released stacks are kept (up to max_cached) and
+ * handed out again, which saves the mmap/munmap (and the page faults of the first use) for every new thread.
+ *
+ * Use Thread::set_stack(StackPool&) to run a thread on a stack of the pool. The pool must exist until all stacks
+ * are released.
+ */
+class StackPool final
+{
+    private:
+        //! usable size of a stack (multiple of the page size)
+        std::size_t stack_size;
+
+        //! size of the guard area below a stack (multiple of the page size)
+        std::size_t guard_size;
+
+        //! maximum number of cached stacks
+        std::size_t max_cached;
+
+        //! number of stacks that are currently acquired
+        std::size_t acquired;
+
+        //! cached stacks (usable base addresses)
+        std::vector<void*> cached;
+
+        //! protects cached and acquired
+        Mutex mutex;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+        //! unmap a stack (usable base address)
+        void unmap(void *stack);
+
+    public:
+        /*! Create a new StackPool
+         *
+         * attributes:
+         *      - stack_size : usable size of a stack, rounded up to the page size (at least PTHREAD_STACK_MIN)
+         *      - max_cached : maximum number of released stacks that are kept for reuse
+         *      - guard_size : size of the guard area below a stack, rounded up to the page size
+         *
+         * possible throws:
+         *      - std::invalid_argument: stack_size is smaller than PTHREAD_STACK_MIN
+         *      - std::system_error    : a system call failed
+         */
+        explicit StackPool(std::size_t stack_size, std::size_t max_cached = 64, std::size_t guard_size = 4096);
+
+        //! Unmap the cached stacks, not virtual because object is final and does not inherit
+        ~StackPool( );
+
+        //! Copying not allowed for objects of this type
+        StackPool(StackPool &other) = delete;
+        //! Copying not allowed for objects of this type
+        StackPool& operator=(StackPool &other) = delete;
+
+        //! Moving not allowed, Thread objects reference the pool
+        StackPool(StackPool &&other) = delete;
+        //! Moving not allowed, Thread objects reference the pool
+        StackPool& operator=(StackPool &&other) = delete;
+
+        /*! get a stack (cached or newly mapped)
+         *
+         * return value: lowest usable address of the stack (size: get_stack_size())
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void* acquire( );
+
+        /*! release a stack, that was returned by acquire()
+         *
+         * The stack must not be used anymore (the thread that used it must be joined).
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void release(void *stack);
+
+        //! get the usable size of a stack
+        inline std::size_t get_stack_size( ) const noexcept;
+
+        //! get the size of the guard area below a stack
+        inline std::size_t get_guard_size( ) const noexcept;
+
+        //! get the number of cached stacks
+        std::size_t get_cached_count( );
+
+        //! get the number of acquired (not released) stacks
+        std::size_t get_acquired_count( );
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+inline std::size_t StackPool::get_stack_size( ) const noexcept
+{
+    return stack_size;
+}
+
+inline std::size_t StackPool::get_guard_size( ) const noexcept
+{
+    return guard_size;
+}
+
+inline void StackPool::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
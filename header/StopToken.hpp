@@ -0,0 +1,345 @@
+/*
+ * \file StopToken.hpp
+ * \brief Header file de::Koesling::Threading::StopSource, de::Koesling::Threading::StopToken and
+ *        de::Koesling::Threading::StopCallback
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+class StopSource;
+class StopToken;
+template<typename Callback> class StopCallback;
+
+//! internal types of StopSource, StopToken and StopCallback
+namespace stop_internal {
+
+class stop_state;
+
+//! type independent part of a StopCallback (node of the callback list of a stop_state)
+class callback_base
+{
+    private:
+        friend class stop_state;
+
+        //! previous registered callback
+        callback_base *prev;
+
+        //! next registered callback
+        callback_base *next;
+
+        //! true: the callback is in the list of the stop_state
+        bool linked;
+
+        //! set to true if the callback object is destroyed by its own execution, nullptr: not executing
+        bool *destroyed;
+
+        //! futex word: 0: not executed, 1: executing and the owner waits, 2: executed
+        std::atomic<int> done;
+
+        //! execute the callback
+        void (*invoke)(callback_base *callback);
+
+    protected:
+        //! Create a new callback_base
+        explicit callback_base(void (*invoke)(callback_base *callback)) noexcept;
+
+        //! Destroy Object
+        ~callback_base( ) = default;
+
+    public:
+        //! Copying not allowed for objects of this type
+        callback_base(callback_base &other) = delete;
+        //! Copying not allowed for objects of this type
+        callback_base& operator=(callback_base &other) = delete;
+
+        //! Moving not allowed, the stop_state references the callback
+        callback_base(callback_base &&other) = delete;
+        //! Moving not allowed, the stop_state references the callback
+        callback_base& operator=(callback_base &&other) = delete;
+};
+
+/*! \brief State shared by StopSource, StopToken and StopCallback objects
+ *
+ * The callbacks are stored in an intrusive list that is protected by a futex based lock. The lock is not held while
+ * a callback is executed, so a callback may register or deregister other callbacks.
+ */
+class stop_state final
+{
+    private:
+        //! true: stop requested
+        std::atomic<bool> stopped;
+
+        //! protects the callback list, executing and requesting_thread (futex word, see futex_lock)
+        std::atomic<int> lock_word;
+
+        //! registered callbacks that were not executed yet
+        callback_base *head;
+
+        //! callback that is currently executed by request_stop, nullptr: none
+        callback_base *executing;
+
+        //! thread that requested the stop (executes the callbacks)
+        pthread_t requesting_thread;
+
+    public:
+        //! Create a new stop_state
+        stop_state( ) noexcept;
+
+        //! Copying not allowed for objects of this type
+        stop_state(stop_state &other) = delete;
+        //! Copying not allowed for objects of this type
+        stop_state& operator=(stop_state &other) = delete;
+
+        //! Moving not allowed for objects of this type
+        stop_state(stop_state &&other) = delete;
+        //! Moving not allowed for objects of this type
+        stop_state& operator=(stop_state &&other) = delete;
+
+        //! check whether a stop was requested
+        inline bool stop_requested( ) const noexcept;
+
+        /*! request a stop and execute the registered callbacks
+         *
+         * return value: false if a stop was requested before
+         */
+        bool request_stop( ) noexcept;
+
+        /*! add a callback to the list
+         *
+         * return value: false if a stop was already requested (the callback is not added)
+         */
+        bool add_callback(callback_base &callback) noexcept;
+
+        /*! remove a callback from the list
+         *
+         * Waits until the callback completed if it is currently executed by another thread.
+         */
+        void remove_callback(callback_base &callback) noexcept;
+};
+
+inline bool stop_state::stop_requested( ) const noexcept
+{
+    return stopped.load(std::memory_order_acquire);
+}
+
+} /* namespace stop_internal */
+
+/*! \brief Token to check whether a stop was requested (see StopSource)
+ *
+ * Tokens are cheap to copy, all copies refer to the same state. A default constructed token has no state: a stop is
+ * never requested.
+ */
+class StopToken final
+{
+    private:
+        friend class StopSource;
+        template<typename Callback> friend class StopCallback;
+
+        //! shared state, nullptr: no state
+        std::shared_ptr<stop_internal::stop_state> state;
+
+        //! Create a token for a state
+        explicit StopToken(std::shared_ptr<stop_internal::stop_state> state) noexcept;
+
+    public:
+        //! Create a token without state
+        StopToken( ) noexcept = default;
+
+        //! check whether a stop was requested
+        inline bool stop_requested( ) const noexcept;
+
+        //! check whether the token has a state (a stop can be requested)
+        inline bool stop_possible( ) const noexcept;
+
+        //! check whether two tokens refer to the same state
+        inline bool operator==(const StopToken &other) const noexcept;
+
+        //! check whether two tokens refer to different states
+        inline bool operator!=(const StopToken &other) const noexcept;
+};
+
+/*! \brief Request a cooperative stop of one or more threads
+ *
+ * Threads receive a StopToken and check stop_requested() regularly or block in waits that are interrupted by a
+ * stop request (Condition::wait(Mutex&, const StopToken&, Predicate), Semaphore::wait(const StopToken&, unsigned int)).
+ * Unlike pthread_cancel the thread decides where it stops, so no lock stays held and no data is left inconsistent.
+ *
+ * StopSource objects are cheap to copy, all copies refer to the same state.
+ */
+class StopSource final
+{
+    private:
+        //! shared state, nullptr: moved from
+        std::shared_ptr<stop_internal::stop_state> state;
+
+    public:
+        /*! Create a new StopSource with a new state
+         *
+         * possible throws:
+         *      - std::bad_alloc: out of memory
+         */
+        StopSource( );
+
+        //! Create a StopSource without state (a stop can not be requested)
+        explicit StopSource(std::nullptr_t) noexcept;
+
+        /*! \brief request a stop
+         *
+         * The registered StopCallback objects are executed by the calling thread before the method returns.
+         * Callbacks that are registered afterwards are executed immediately.
+         *
+         * return value: false if a stop was requested before or the StopSource has no state (moved from)
+         */
+        bool request_stop( ) noexcept;
+
+        //! check whether a stop was requested
+        inline bool stop_requested( ) const noexcept;
+
+        //! check whether the source has a state (false if moved from)
+        inline bool stop_possible( ) const noexcept;
+
+        //! get a token for the state of this source
+        inline StopToken get_token( ) const noexcept;
+};
+
+/*! \brief Callback that is executed when a stop is requested
+ *
+ * The callback is executed once: by the thread that calls StopSource::request_stop() or by the constructor if a stop
+ * was already requested. It is not executed if the StopCallback is destroyed before. The destructor waits until the
+ * callback completed if it is executed by another thread at the same time.
+ *
+ * The callback must not throw (std::terminate is called).
+ *
+ * template arguments:
+ *      - Callback: type of the callback, invoked without arguments
+ */
+template<typename Callback = std::function<void()>>
+class StopCallback final : private stop_internal::callback_base
+{
+    private:
+        //! the callback
+        Callback callback;
+
+        //! shared state, nullptr: not registered
+        std::shared_ptr<stop_internal::stop_state> state;
+
+        //! execute the callback (callback_base::invoke)
+        static void run(callback_base *base) noexcept;
+
+    public:
+        /*! Register a callback
+         *
+         * attributes:
+         *      - token   : token of the state the callback is registered at
+         *      - callback: callback, copied or moved into the object
+         *
+         * possible throws:
+         *      - any exception thrown while copying/moving the callback
+         */
+        template<typename C>
+        StopCallback(const StopToken &token, C &&callback);
+
+        //! Deregister the callback, not virtual because object is final and does not inherit
+        ~StopCallback( );
+
+        //! Copying not allowed for objects of this type
+        StopCallback(StopCallback &other) = delete;
+        //! Copying not allowed for objects of this type
+        StopCallback& operator=(StopCallback &other) = delete;
+
+        //! Moving not allowed, the stop state references the callback
+        StopCallback(StopCallback &&other) = delete;
+        //! Moving not allowed, the stop state references the callback
+        StopCallback& operator=(StopCallback &&other) = delete;
+};
+
+// ------------------- Template functions for class StopCallback -----------
+
+template<typename Callback>
+template<typename C>
+StopCallback<Callback>::StopCallback(const StopToken &token, C &&callback) :
+        callback_base(run),
+        callback(std::forward<C>(callback))
+{
+    if (!token.state) return;
+
+    if (token.state->add_callback(*this)) state = token.state;
+    else run(this);
+}
+
+template<typename Callback>
+StopCallback<Callback>::~StopCallback( )
+{
+    if (state) state->remove_callback(*this);
+}
+
+template<typename Callback>
+void StopCallback<Callback>::run(callback_base *base) noexcept
+{
+    static_cast<StopCallback*>(base)->callback( );
+}
+
+// ------------------- Inline functions ------------------------------------
+
+inline bool StopToken::stop_requested( ) const noexcept
+{
+    return state && state->stop_requested( );
+}
+
+inline bool StopToken::stop_possible( ) const noexcept
+{
+    return static_cast<bool>(state);
+}
+
+inline bool StopToken::operator==(const StopToken &other) const noexcept
+{
+    return state == other.state;
+}
+
+inline bool StopToken::operator!=(const StopToken &other) const noexcept
+{
+    return state != other.state;
+}
+
+inline bool StopSource::stop_requested( ) const noexcept
+{
+    return state && state->stop_requested( );
+}
+
+inline bool StopSource::stop_possible( ) const noexcept
+{
+    return static_cast<bool>(state);
+}
+
+inline StopToken StopSource::get_token( ) const noexcept
+{
+    return StopToken(state);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
@@ -3,7 +3,7 @@
  * \brief Header file de::Koesling::Threading::Thread
  *
  * required compiler options:
- *          -std=c++11 (or higher)
+ *          -std=c++14 (or higher)
  *          -pthread
  *
  * recommended compiler options:
@@ -15,8 +15,23 @@
 
 #pragma once
 
+#include "CpuSet.hpp"
+#include "StopToken.hpp"
+
 #include <pthread.h>
+#include <sys/types.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <new>
 #include <ostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace de {
 namespace Koesling {
@@ -24,6 +39,8 @@ namespace Threading {
 
     //! Thread function type
     typedef void* (*thread_function_t)(void*);
+
+    class StackPool;
     
     /*! \brief Create threads based on pthread
      *
@@ -39,6 +56,33 @@ namespace Threading {
                 DETACHED	//!< Thread is detached
             };
 
+            //! scheduling policies (see man sched)
+            enum policy_t
+            {
+                OTHER,      //!< SCHED_OTHER: default time sharing
+                FIFO,       //!< SCHED_FIFO: real-time, first in first out
+                RR,         //!< SCHED_RR: real-time, round robin
+                BATCH,      //!< SCHED_BATCH: CPU intensive, non interactive
+                IDLE,       //!< SCHED_IDLE: very low priority background jobs
+                DEADLINE    //!< SCHED_DEADLINE: earliest deadline first (see set_deadline)
+            };
+
+            //! maximum length of a thread name (without terminating null byte, see man pthread_setname_np)
+            static constexpr std::size_t NAME_MAX_LENGTH = 15;
+
+            //! information about a running thread (see get_threads)
+            struct thread_info_t
+            {
+                //! kernel thread id
+                pid_t tid;
+                //! name of the thread
+                std::string name;
+                //! state of the thread (see man proc, /proc/[pid]/stat: R, S, D, T, ...)
+                char state;
+                //! consumed CPU time
+                struct timespec cpu_time;
+            };
+
         private:
             /*! \brief ID of the created thread.
              *
@@ -82,9 +126,188 @@ namespace Threading {
              */
             void *arguments;
 
+            //! stack set with set_stack(...), nullptr: allocated by pthread_create
+            void *stack;
+
+            //! pool of the stack, nullptr: stack is not from a pool
+            StackPool *stack_pool;
+
+            /*! \brief The stack might be used by the thread
+             *
+             * Set by start(), cleared when the thread is joined. A pool stack
+             * is only returned to its pool if it is not in use. Stacks of
+             * detached or cancelled threads are never returned, because it is
+             * unknown when the thread stops using it.
+             */
+            bool stack_in_use;
+
             //! error message stream for "non-throwable" errors
             static std::ostream* error_stream;
 
+            //! size of the inline storage for callables (small-buffer optimization)
+            static constexpr std::size_t CALLABLE_BUFFER_SIZE = 64;
+
+            //! operations on the stored callable (type erasure)
+            struct callable_ops_t
+            {
+                //! thread function (argument: Thread object), takes the callable out of the Thread and executes it
+                thread_function_t run;
+
+                //! move the callable from one buffer to another and destroy the source
+                void (*relocate)(void *from, void *to);
+
+                //! destroy the callable in the buffer
+                void (*destroy)(void *buffer);
+            };
+
+            //! state of the stored callable
+            enum callable_state_t : int
+            {
+                CALLABLE_STORED   = 0,  //!< callable is stored in the Thread object
+                CALLABLE_STARTED  = 1,  //!< thread is started, but did not take the callable yet
+                CALLABLE_WAITING  = 2,  //!< like CALLABLE_STARTED, the owner of the Thread object waits for the thread
+                CALLABLE_CONSUMED = 3   //!< the thread took the callable / no callable
+            };
+
+            /*! \brief Implementation of callable_ops_t for a callable type
+             *
+             * template arguments:
+             *   - Callable: std::tuple of the function object and its arguments
+             *   - Inline  : true : the callable is stored in callable_buffer
+             *               false: callable_buffer holds a pointer to the heap allocated callable
+             */
+            template<typename Callable, bool Inline>
+            struct callable_impl;
+
+            //! decide whether a callable is stored inline
+            template<typename Callable>
+            using callable_is_inline = std::integral_constant<bool, sizeof(Callable) <= CALLABLE_BUFFER_SIZE &&
+                    alignof(Callable) <= alignof(std::max_align_t) &&
+                    std::is_nothrow_move_constructible<Callable>::value>;
+
+            /*! \brief Storage for the callable
+             *
+             * Small callables are stored inline, so starting a thread with a (capturing) lambda requires no
+             * additional allocation. Larger callables are allocated on the heap, the buffer holds the pointer.
+             */
+            typename std::aligned_storage<CALLABLE_BUFFER_SIZE, alignof(std::max_align_t)>::type callable_buffer;
+
+            //! operations on the stored callable, nullptr: thread function is used
+            const callable_ops_t *callable_ops;
+
+            /*! \brief state of the thread startup and the stored callable (futex word)
+             *
+             * The started thread publishes its thread id, applies the startup settings and moves the callable (or
+             * reads the thread function and its arguments). The Thread object must not be moved or destroyed until
+             * this happened.
+             */
+            std::atomic<int> callable_state;
+
+            //! settings that can not be stored in the pthread attributes, applied by the started thread
+            struct startup_settings_t
+            {
+                //! true: set the nice value
+                bool set_nice;
+                //! nice value
+                int nice;
+                //! true: switch to SCHED_DEADLINE
+                bool set_deadline;
+                //! SCHED_DEADLINE runtime in ns
+                std::uint64_t runtime;
+                //! SCHED_DEADLINE relative deadline in ns
+                std::uint64_t deadline;
+                //! SCHED_DEADLINE period in ns
+                std::uint64_t period;
+            };
+
+            //! settings applied by the started thread
+            startup_settings_t startup;
+
+            //! error number of the startup of the thread, 0: no error
+            int startup_error;
+
+            //! kernel thread id of the started thread, 0: not started
+            pid_t tid;
+
+            //! name set with set_name(...), applied by the started thread (empty: inherit the name)
+            char name[NAME_MAX_LENGTH + 1];
+
+            //! requests a cooperative stop of the thread (see request_stop)
+            StopSource stop_source;
+
+            /*! \brief called by the started thread before anything else
+             *
+             * Publishes the thread id, registers the thread (see get_threads), sets the name and applies the startup
+             * settings. If applying the settings fails, the error is
+             * stored in startup_error, the callable stays in the Thread object and the thread must return
+             * immediately.
+             *
+             * return value: false if the startup failed
+             */
+            static bool thread_startup(Thread *self) noexcept;
+
+            //! thread function for threads created with a thread_function_t (calls the function)
+            static void* function_trampoline(void *thread);
+
+            //! Create a Thread with default attributes (used by the callable constructor)
+            explicit Thread(std::nullptr_t);
+
+            /*! \brief called by the started thread after it took the callable out of the Thread object
+             *
+             * The Thread object might be moved or destroyed once this function was called.
+             * new_state: CALLABLE_CONSUMED, or CALLABLE_STORED if the callable was not taken (startup failed)
+             */
+            static void callable_taken(std::atomic<int> &state, int new_state = CALLABLE_CONSUMED) noexcept;
+
+            //! wait until the started thread took the callable out of this object
+            void wait_callable_taken( ) noexcept;
+
+            //! throw std::logic_error if the stack can not be changed (thread is running)
+            void check_stack_changeable( ) const;
+
+            /*! \brief check whether the settings of the started thread are accessed
+             *
+             * A detached thread might have terminated: its pthread_t and its
+             * thread id must not be used anymore.
+             *
+             * return value: true : the thread is running (system calls on
+             *                      the thread)
+             *               false: the thread is not started (attributes)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is running and detached
+             */
+            bool access_running( ) const;
+
+            //! return the pool stack to its pool (if it is not in use)
+            void release_stack( ) noexcept;
+
+            //! execute the function object stored in a tuple with the arguments stored in the tuple
+            template<typename Callable, std::size_t... Index>
+            static void invoke(Callable &callable, std::index_sequence<Index...>);
+
+            //! check whether a callable accepts a StopToken as first argument (followed by the arguments)
+            template<typename Function, typename... Args>
+            struct accepts_stop_token
+            {
+                template<typename F>
+                static auto test(int) -> decltype(std::declval<F>( )(std::declval<StopToken>( ),
+                        std::declval<typename std::decay<Args>::type>( )...), std::true_type( ));
+
+                template<typename F>
+                static std::false_type test(...);
+
+                static constexpr bool value = decltype(test<typename std::decay<Function>::type>(0))::value;
+            };
+
+            //! store the callable and the arguments (without StopToken)
+            template<typename Function, typename... Args>
+            void store_callable(std::false_type, Function &&function, Args&&... arguments);
+
+            //! store the callable, a StopToken of the Thread and the arguments
+            template<typename Function, typename... Args>
+            void store_callable(std::true_type, Function &&function, Args&&... arguments);
+
         public:
             /*! \brief Create a Thread with default attributes
              *
@@ -104,9 +327,12 @@ namespace Threading {
              *     Inherit scheduler   = PTHREAD_INHERIT_SCHED
              *     Scheduling policy   = SCHED_OTHER
              *     Scheduling priority = 0
-             *     Guard size          = 4096 bytes
-             *     Stack address       = 0x40196000
-             *     Stack size          = 0x201000 bytes
+             *     Guard size          = one page (4096 bytes on most systems)
+             *     Stack address       = allocated by pthread_create
+             *     Stack size          = soft limit RLIMIT_STACK (usually 8 MiB, see ulimit -s),
+             *                           architecture default (2 MiB on x86_64) if unlimited
+             *
+             *     see set_stack_size(...), set_guard_size(...) and set_stack(...) to change the stack
              */
             explicit Thread(thread_function_t function);
 
@@ -133,9 +359,12 @@ namespace Threading {
              *     Inherit scheduler   = PTHREAD_INHERIT_SCHED
              *     Scheduling policy   = SCHED_OTHER
              *     Scheduling priority = 0
-             *     Guard size          = 4096 bytes
-             *     Stack address       = 0x40196000
-             *     Stack size          = 0x201000 bytes
+             *     Guard size          = one page (4096 bytes on most systems)
+             *     Stack address       = allocated by pthread_create
+             *     Stack size          = soft limit RLIMIT_STACK (usually 8 MiB, see ulimit -s),
+             *                           architecture default (2 MiB on x86_64) if unlimited
+             *
+             *     see set_stack_size(...), set_guard_size(...) and set_stack(...) to change the stack
              */
             Thread(thread_function_t function, detachstate_t detachstate);
 
@@ -155,9 +384,45 @@ namespace Threading {
              */
             Thread(thread_function_t function, const pthread_attr_t &attributes);
 
+            /*! \brief Create a Thread with default attributes that executes
+             *         a callable
+             *
+             * The callable (e.g. a lambda) and the arguments are copied or
+             * moved into the Thread object (like std::thread). Small
+             * callables are stored inline (no allocation). When the thread is
+             * started, it moves the callable to its own stack.
+             *
+             * If the callable accepts a StopToken as first argument (like the
+             * function of std::jthread), it is called with the token of the
+             * Thread (see request_stop) followed by the arguments.
+             *
+             * The return value of the callable is ignored (join() returns
+             * nullptr). If the callable throws an exception, std::terminate
+             * is called. The Thread can only be started once.
+             *
+             * arguments:
+             *   - function : callable, invoked with the arguments
+             *   - arguments: arguments passed to the callable
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man pages:
+             *                          - pthread_attr_init
+             *   - any exception thrown while copying/moving the callable or
+             *     the arguments or std::bad_alloc
+             */
+            template<typename Function, typename... Args, typename = typename std::enable_if<
+                    !std::is_same<typename std::decay<Function>::type, Thread>::value &&
+                    !std::is_convertible<Function, thread_function_t>::value>::type>
+            explicit Thread(Function &&function, Args&&... arguments);
+
             /*! \brief Destroy the Thread object.
              *
-             * Thread is terminated if running.
+             * If the thread is running and joinable, a stop is requested
+             * (see request_stop) and the thread is joined (like
+             * std::jthread). The thread is not cancelled: it must observe
+             * its StopToken or terminate on its own.
              * Program is terminated if system call fails. (unlikely)
              */
             virtual ~Thread( );
@@ -175,6 +440,11 @@ namespace Threading {
             Thread& operator=(Thread &&other) noexcept;
 
             /*! \brief Start the Thread
+             *
+             * If the thread was started before and a stop was requested, the
+             * thread gets a new StopSource: the stop request of the previous
+             * run does not stop the new one. StopSource and StopToken objects
+             * obtained before refer to the previous run.
              *
              * possible throws:
              *   - std::logic_error : Programming mistake. Should never happen
@@ -184,6 +454,7 @@ namespace Threading {
              *                        set according to <cerrno>.
              *                        possible error numbers see man page(s):
              *                          - pthread_create
+             *   - std::bad_alloc   : out of memory (new StopSource)
              */
             void start( );
 
@@ -272,6 +543,7 @@ namespace Threading {
             /*! \brief Stops the thread immediately.
              *
              * Data corruption is possible. --> Avoid if somehow possible!
+             * Use request_stop() to stop the thread cooperatively.
              *
              * possible throws:
              *   - std::logic_error : Programming mistake. Should never happen
@@ -309,6 +581,406 @@ namespace Threading {
              */
             inline void kill(int signum);
 
+            /*! \brief Set the CPU affinity of the thread
+             *
+             * Before start(): the affinity is stored in the thread attributes
+             * and applied when the thread is created.
+             * After start(): the affinity of the running thread is changed.
+             *
+             * arguments:
+             *   - cpus : CPUs the thread may run on (see Topology::place)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::invalid_argument: cpus is empty
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_setaffinity_np
+             *                          - pthread_setaffinity_np
+             */
+            void set_affinity(const CpuSet &cpus);
+
+            /*! \brief Get the CPU affinity of the thread
+             *
+             * Before start(): the affinity stored in the thread attributes
+             * (all CPUs if none was set).
+             * After start(): the affinity of the running thread.
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_getaffinity_np
+             *                          - pthread_getaffinity_np
+             */
+            CpuSet get_affinity( ) const;
+
+            /*! \brief Set the CPU affinity of the calling thread
+             *
+             * possible throws:
+             *   - std::invalid_argument: cpus is empty
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_setaffinity_np
+             */
+            static void set_my_affinity(const CpuSet &cpus);
+
+            /*! \brief Get the CPU affinity of the calling thread
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_getaffinity_np
+             */
+            static CpuSet get_my_affinity( );
+
+            /*! \brief Set the stack size of the thread (before start)
+             *
+             * Threads that mainly wait for I/O need far less than the
+             * default stack size (usually 8 MiB, see ulimit -s). Only
+             * virtual memory is reserved, but thousands of threads with
+             * default stacks exhaust the address space or the overcommit
+             * limit.
+             *
+             * arguments:
+             *   - size : stack size in bytes (at least PTHREAD_STACK_MIN)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is running or a stack was set
+             *                        with set_stack(...)
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_setstacksize
+             */
+            void set_stack_size(std::size_t size);
+
+            /*! \brief Set the size of the guard area below the stack
+             *         (before start)
+             *
+             * Ignored if a stack is set with set_stack(...).
+             *
+             * arguments:
+             *   - size : guard size in bytes (rounded up to the page size,
+             *            0: no guard area)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is running
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_setguardsize
+             */
+            void set_guard_size(std::size_t size);
+
+            /*! \brief Run the thread on a user supplied stack (before start)
+             *
+             * The memory must stay valid until the thread is joined. No guard
+             * area is created.
+             *
+             * arguments:
+             *   - stack : lowest address of the stack
+             *   - size  : stack size in bytes (at least PTHREAD_STACK_MIN)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is running
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_setstack
+             */
+            void set_stack(void *stack, std::size_t size);
+
+            /*! \brief Run the thread on a stack of a StackPool (before start)
+             *
+             * The stack is returned to the pool when the Thread object is
+             * destroyed or gets another stack after the thread was joined.
+             * The pool must exist until then.
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is running
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - mmap
+             *                          - mprotect
+             *                          - pthread_attr_setstack
+             */
+            void set_stack(StackPool &pool);
+
+            /*! \brief Get the stack size of the thread
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_getstacksize
+             */
+            std::size_t get_stack_size( ) const;
+
+            /*! \brief Get the guard size of the thread
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_getguardsize
+             */
+            std::size_t get_guard_size( ) const;
+
+            /*! \brief Set the scheduling policy and priority
+             *
+             * Before start(): stored in the thread attributes
+             * (PTHREAD_EXPLICIT_SCHED), applied when the thread is created.
+             * After start(): the policy of the running thread is changed.
+             *
+             * Real-time policies (FIFO, RR) require CAP_SYS_NICE or a
+             * sufficient RLIMIT_RTPRIO. Missing privileges are reported as
+             * std::system_error (EPERM) with an explanation, by start() if
+             * the policy was set before.
+             *
+             * arguments:
+             *   - policy  : scheduling policy (DEADLINE: use set_deadline)
+             *   - priority: static priority (FIFO, RR: 1 - 99, others: 0)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::invalid_argument: invalid policy or priority
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_setinheritsched
+             *                          - pthread_attr_setschedpolicy
+             *                          - pthread_attr_setschedparam
+             *                          - pthread_setschedparam
+             */
+            void set_scheduling(policy_t policy, int priority = 0);
+
+            /*! \brief Use SCHED_DEADLINE
+             *
+             * The thread receives runtime every period and the runtime must
+             * be consumed within deadline after the beginning of the period.
+             * Before start(): applied by the started thread, start() fails
+             * if this is not possible. After start(): the policy of the
+             * running thread is changed.
+             *
+             * Requires CAP_SYS_NICE. The kernel rejects parameters that
+             * exceed the available bandwidth (EBUSY).
+             *
+             * arguments:
+             *   - runtime : runtime per period
+             *   - deadline: relative deadline (runtime <= deadline)
+             *   - period  : period (deadline <= period)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::invalid_argument: invalid parameters
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - sched_setattr
+             */
+            void set_deadline(const struct timespec &runtime, const struct timespec &deadline,
+                    const struct timespec &period);
+
+            /*! \brief Set the nice value (SCHED_OTHER, SCHED_BATCH)
+             *
+             * Before start(): applied by the started thread, start() fails
+             * if this is not possible. After start(): the nice value of the
+             * running thread is changed.
+             *
+             * Lowering the nice value requires CAP_SYS_NICE or a sufficient
+             * RLIMIT_NICE.
+             *
+             * arguments:
+             *   - nice: nice value (-20 - 19)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::invalid_argument: invalid nice value
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - setpriority
+             */
+            void set_nice(int nice);
+
+            /*! \brief Get the scheduling policy
+             *
+             * Before start(): the policy stored in the thread attributes or
+             * DEADLINE if set_deadline was called.
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_getschedpolicy
+             *                          - pthread_getschedparam
+             */
+            policy_t get_policy( ) const;
+
+            /*! \brief Get the static scheduling priority
+             *
+             * Before start(): the priority stored in the thread attributes.
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_attr_getschedparam
+             *                          - pthread_getschedparam
+             */
+            int get_priority( ) const;
+
+            /*! \brief Get the nice value
+             *
+             * Before start(): the value set with set_nice or the nice value
+             * of the calling thread (inherited by the new thread).
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - getpriority
+             */
+            int get_nice( );
+
+            /*! \brief Get the kernel thread id (gettid) of the thread
+             *
+             * return value: thread id, 0 if the thread was not started
+             */
+            pid_t get_tid( ) noexcept;
+
+            /*! \brief Set the name of the thread
+             *
+             * The name is shown by tools like top -H, ps -L and gdb.
+             * Before start(): applied by the started thread.
+             * After start(): the name of the running thread is changed.
+             *
+             * arguments:
+             *   - name : name of the thread (at most NAME_MAX_LENGTH
+             *            characters)
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::invalid_argument: name is too long
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_setname_np
+             */
+            void set_name(const std::string &name);
+
+            /*! \brief Get the name of the thread
+             *
+             * Before start(): the name set with set_name (empty if no name
+             * was set).
+             * After start(): the name of the running thread.
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is detached (might have
+             *                        terminated)
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_getname_np
+             */
+            std::string get_name( ) const;
+
+            /*! \brief Get the CPU time consumed by the thread
+             *
+             * The thread must not be joined. The CPU time of a terminated
+             * thread that was not joined yet can not be determined.
+             *
+             * possible throws:
+             *   - std::logic_error : the thread is not running or detached
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - pthread_getcpuclockid
+             *                          - clock_gettime
+             */
+            struct timespec get_cpu_time( ) const;
+
+            /*! \brief Set the name of the calling thread
+             *
+             * see set_name(...)
+             */
+            static void set_my_name(const std::string &name);
+
+            /*! \brief Get the CPU time consumed by the calling thread
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - clock_gettime
+             */
+            static struct timespec get_my_cpu_time( );
+
+            /*! \brief Get information about all threads started by a Thread
+             *         object that are running
+             *
+             * Every thread started with start() is registered until it
+             * terminates (also if it is detached or cancelled). Threads that
+             * were created otherwise (e.g. the main thread) are not listed.
+             * Name and state are read from /proc/self/task/<tid>/stat.
+             *
+             * possible throws:
+             *   - std::system_error: A system call failed. An error number is
+             *                        set according to <cerrno>.
+             *                        possible error numbers see man page(s):
+             *                          - clock_gettime
+             *   - std::bad_alloc   : out of memory
+             */
+            static std::vector<thread_info_t> get_threads( );
+
+            /*! \brief Request a cooperative stop of the thread
+             *
+             * The StopToken of the thread reports the stop and waits that
+             * use the token (Condition::wait(Mutex&, const StopToken&,
+             * Predicate), Semaphore::wait(const StopToken&, unsigned int))
+             * return. Registered StopCallback objects are executed by the
+             * calling thread.
+             *
+             * The thread receives the token as first argument of its callable
+             * (see constructor) or via get_my_stop_token().
+             *
+             * return value: false if a stop was requested before
+             */
+            inline bool request_stop( ) noexcept;
+
+            //! Get the StopSource of the thread
+            inline StopSource get_stop_source( ) const noexcept;
+
+            //! Get the StopToken of the thread
+            inline StopToken get_stop_token( ) const noexcept;
+
+            /*! \brief Get the StopToken of the calling thread
+             *
+             * return value: token of the Thread object that started the
+             *               calling thread, a token without state (a stop is
+             *               never requested) if the calling thread was not
+             *               started by a Thread object
+             */
+            static StopToken get_my_stop_token( ) noexcept;
+
             /*! \brief Set arguments for call of thread function
              *
              * see 'man pthread_create' and 'man pthread_attr_*' for more
@@ -322,7 +994,7 @@ namespace Threading {
              */
             inline pthread_t get_id( ) noexcept;
 
-            //! Get a pointer to the thread function
+            //! Get a pointer to the thread function (nullptr if the Thread executes a callable)
             inline thread_function_t get_function( ) noexcept;
 
             /*! \brief Compare two Thread objects by ID.
@@ -354,6 +1026,130 @@ namespace Threading {
     //! write de::Koesling::Threading::Thread::detachstate_t as string to an output stream
     std::ostream& operator << (std::ostream& os, de::Koesling::Threading::Thread::detachstate_t ds);
 
+    // ------------------- Template functions for class Thread -----------------
+
+    template<typename Callable>
+    struct Thread::callable_impl<Callable, true>
+    {
+        static Callable* get(void *buffer) noexcept
+        {
+            return static_cast<Callable*>(buffer);
+        }
+
+        template<typename... Values>
+        static void construct(void *buffer, Values&&... values)
+        {
+            new (buffer) Callable(std::forward<Values>(values)...);
+        }
+
+        static void* run(void *thread)
+        {
+            Thread *self = static_cast<Thread*>(thread);
+            if (!thread_startup(self)) return nullptr;
+
+            // move the callable to the stack of this thread, the Thread object may be moved afterwards
+            Callable callable(std::move(*get(&self->callable_buffer)));
+            get(&self->callable_buffer)->~Callable( );
+            callable_taken(self->callable_state);
+
+            invoke(callable, std::make_index_sequence<std::tuple_size<Callable>::value - 1>( ));
+            return nullptr;
+        }
+
+        static void relocate(void *from, void *to)
+        {
+            new (to) Callable(std::move(*get(from)));
+            get(from)->~Callable( );
+        }
+
+        static void destroy(void *buffer)
+        {
+            get(buffer)->~Callable( );
+        }
+
+        static const callable_ops_t ops;
+    };
+
+    template<typename Callable>
+    const Thread::callable_ops_t Thread::callable_impl<Callable, true>::ops = {run, relocate, destroy};
+
+    template<typename Callable>
+    struct Thread::callable_impl<Callable, false>
+    {
+        static Callable*& get(void *buffer) noexcept
+        {
+            return *static_cast<Callable**>(buffer);
+        }
+
+        template<typename... Values>
+        static void construct(void *buffer, Values&&... values)
+        {
+            new (buffer) Callable*(new Callable(std::forward<Values>(values)...));
+        }
+
+        static void* run(void *thread)
+        {
+            Thread *self = static_cast<Thread*>(thread);
+            if (!thread_startup(self)) return nullptr;
+
+            // take the ownership, the Thread object may be moved afterwards
+            std::unique_ptr<Callable> callable(get(&self->callable_buffer));
+            callable_taken(self->callable_state);
+
+            invoke(*callable, std::make_index_sequence<std::tuple_size<Callable>::value - 1>( ));
+            return nullptr;
+        }
+
+        static void relocate(void *from, void *to)
+        {
+            new (to) Callable*(get(from));
+        }
+
+        static void destroy(void *buffer)
+        {
+            delete get(buffer);
+        }
+
+        static const callable_ops_t ops;
+    };
+
+    template<typename Callable>
+    const Thread::callable_ops_t Thread::callable_impl<Callable, false>::ops = {run, relocate, destroy};
+
+    template<typename Callable, std::size_t... Index>
+    void Thread::invoke(Callable &callable, std::index_sequence<Index...>)
+    {
+        std::move(std::get<0>(callable))(std::move(std::get<Index + 1>(callable))...);
+    }
+
+    template<typename Function, typename... Args, typename>
+    Thread::Thread(Function &&function, Args&&... arguments) :
+            Thread(nullptr)
+    {
+        store_callable(std::integral_constant<bool, accepts_stop_token<Function, Args...>::value>( ),
+                std::forward<Function>(function), std::forward<Args>(arguments)...);
+    }
+
+    template<typename Function, typename... Args>
+    void Thread::store_callable(std::false_type, Function &&function, Args&&... arguments)
+    {
+        typedef std::tuple<typename std::decay<Function>::type, typename std::decay<Args>::type...> callable_t;
+        typedef callable_impl<callable_t, callable_is_inline<callable_t>::value> impl_t;
+
+        impl_t::construct(&callable_buffer, std::forward<Function>(function), std::forward<Args>(arguments)...);
+
+        // set after the callable was constructed: the destructor destroys the callable if callable_ops is set
+        callable_ops = &impl_t::ops;
+        callable_state.store(CALLABLE_STORED, std::memory_order_relaxed);
+    }
+
+    template<typename Function, typename... Args>
+    void Thread::store_callable(std::true_type, Function &&function, Args&&... arguments)
+    {
+        store_callable(std::false_type( ), std::forward<Function>(function), stop_source.get_token( ),
+                std::forward<Args>(arguments)...);
+    }
+
     // ------------------- Inline functions for class Thread -------------------
 
     inline void Thread::kill(int signum)
@@ -361,6 +1157,21 @@ namespace Threading {
         send_signal(signum);
     }
 
+    inline bool Thread::request_stop( ) noexcept
+    {
+        return stop_source.request_stop( );
+    }
+
+    inline StopSource Thread::get_stop_source( ) const noexcept
+    {
+        return stop_source;
+    }
+
+    inline StopToken Thread::get_stop_token( ) const noexcept
+    {
+        return stop_source.get_token( );
+    }
+
     inline void Thread::set_arguments(void *arguments) noexcept
     {
         this->arguments = arguments;
@@ -0,0 +1,268 @@
+/*
+ * \file ThreadPool.hpp
+ * \brief Header file de::Koesling::Threading::ThreadPool
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "Condition.hpp"
+#include "Mutex.hpp"
+#include "Thread.hpp"
+
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Fixed-size pool of worker threads with a bounded task queue
+ *
+ * The worker threads are started by the constructor and wait for tasks. Tasks are executed in the order they were
+ * submitted. If the queue is full, submit() blocks until a worker took a task.
+ *
+ * Tasks should not throw exceptions. An exception thrown by a task is written to the error stream and the worker
+ * continues with the next task.
+ */
+class ThreadPool final
+{
+    public:
+        //! type of the tasks
+        typedef std::function<void()> task_t;
+
+        //! statistics of a worker thread
+        struct worker_stats_t
+        {
+            //! number of executed tasks
+            unsigned long long tasks_executed;
+
+            //! time spent executing tasks in nanoseconds
+            unsigned long long busy_time_ns;
+
+            //! busy time divided by the lifetime of the pool (0.0 .. 1.0)
+            double utilization;
+        };
+
+    private:
+        //! statistics of a worker thread (updated by the worker)
+        struct worker_t
+        {
+            std::atomic<unsigned long long> tasks_executed;
+            std::atomic<unsigned long long> busy_time_ns;
+        };
+
+        //! protects the queue and the state of the pool
+        Mutex mutex;
+
+        //! signaled if a task was added or the pool is shut down
+        Condition not_empty;
+
+        //! signaled if a task was removed or the pool is shut down
+        Condition not_full;
+
+        //! signaled if the queue is empty and no task is executed
+        Condition idle;
+
+        //! signaled if the worker threads were joined
+        Condition terminated;
+
+        //! ring buffer of queued tasks
+        std::vector<task_t> queue;
+
+        //! index of the oldest task in queue
+        std::size_t queue_head;
+
+        //! number of queued tasks
+        std::size_t queue_depth;
+
+        //! number of tasks currently executed
+        std::size_t active_tasks;
+
+        //! true: no more tasks are accepted, the workers terminate once the queue is empty
+        bool stopping;
+
+        //! true: shutdown() was called, the first caller joins the worker threads
+        bool stopped;
+
+        //! true: the worker threads were joined
+        bool joined;
+
+        //! time point (CLOCK_MONOTONIC, nanoseconds) when the pool was created
+        unsigned long long start_time_ns;
+
+        //! statistics of the worker threads
+        std::unique_ptr<worker_t[]> worker_data;
+
+        //! worker threads
+        std::vector<Thread> workers;
+
+        //! error message stream for "non-throwable" errors
+        static std::ostream* error_stream;
+
+        //! main loop of a worker thread
+        void worker(std::size_t index);
+
+        /*! add a task to the queue (mutex must be locked and the queue must not be full)
+         *
+         * The mutex is unlocked by this function.
+         */
+        void enqueue(task_t &&task);
+
+        //! current time (CLOCK_MONOTONIC) in nanoseconds
+        static unsigned long long now_ns( );
+
+    public:
+        /*! Create a new ThreadPool and start the worker threads
+         *
+         * attributes:
+         *      - thread_count  : number of worker threads
+         *      - queue_capacity: maximum number of queued tasks
+         *
+         * possible throws:
+         *      - std::invalid_argument: thread_count or queue_capacity is 0
+         *      - std::system_error    : a system call failed
+         */
+        ThreadPool(unsigned int thread_count, std::size_t queue_capacity);
+
+        //! Shut down the pool (see shutdown()), not virtual because object is final and does not inherit
+        ~ThreadPool( );
+
+        //! Copying not allowed for objects of this type
+        ThreadPool(ThreadPool &other) = delete;
+        //! Copying not allowed for objects of this type
+        ThreadPool& operator=(ThreadPool &other) = delete;
+
+        //! Moving not allowed, the worker threads reference the pool
+        ThreadPool(ThreadPool &&other) = delete;
+        //! Moving not allowed, the worker threads reference the pool
+        ThreadPool& operator=(ThreadPool &&other) = delete;
+
+        /*! submit a task, block while the queue is full
+         *
+         * possible throws:
+         *      - std::invalid_argument: task is empty
+         *      - std::logic_error     : the pool is shut down
+         *      - std::system_error    : a system call failed
+         */
+        void submit(task_t task);
+
+        /*! submit a task if the queue is not full
+         *
+         * return value:
+         *      true : task was queued
+         *      false: queue is full
+         *
+         * possible throws:
+         *      - std::invalid_argument: task is empty
+         *      - std::logic_error     : the pool is shut down
+         *      - std::system_error    : a system call failed
+         */
+        bool try_submit(task_t task);
+
+        /*! submit a task, block while the queue is full (with timeout)
+         *
+         * attributes:
+         *      - task: task to execute
+         *      - time: maximum time to wait for space in the queue
+         *
+         * return value:
+         *      true : task was queued
+         *      false: queue was full within the specified time span
+         *
+         * possible throws:
+         *      - std::invalid_argument: task is empty or time span is invalid
+         *      - std::logic_error     : the pool is shut down
+         *      - std::system_error    : a system call failed
+         */
+        bool timed_submit(task_t task, const timespec &time);
+
+        /*! wait until the queue is empty and all tasks completed
+         *
+         * Must not be called by a task of this pool.
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void drain( );
+
+        /*! stop accepting tasks, execute the queued tasks and join the worker threads
+         *
+         * Must not be called by a task of this pool. Calling shutdown() more than once has no effect, further calls
+         * (also concurrent ones) return once the worker threads were joined.
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        void shutdown( );
+
+        /*! get the number of queued tasks (not including tasks that are currently executed)
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        std::size_t get_queue_depth( );
+
+        /*! get the number of tasks that are currently executed
+         *
+         * possible throws:
+         *      - std::system_error: a system call failed
+         */
+        std::size_t get_active_tasks( );
+
+        /*! get the statistics of a worker thread
+         *
+         * attributes:
+         *      - index: index of the worker thread (0 .. get_thread_count() - 1)
+         *
+         * possible throws:
+         *      - std::out_of_range : invalid index
+         *      - std::system_error : a system call failed
+         */
+        worker_stats_t get_worker_stats(std::size_t index) const;
+
+        //! get the number of worker threads
+        inline std::size_t get_thread_count( ) const noexcept;
+
+        //! get the maximum number of queued tasks
+        inline std::size_t get_queue_capacity( ) const noexcept;
+
+        //! Set stream for error output for "non-throwable" errors
+        inline static void set_error_stream(std::ostream& stream) noexcept;
+};
+
+inline std::size_t ThreadPool::get_thread_count( ) const noexcept
+{
+    return workers.size();
+}
+
+inline std::size_t ThreadPool::get_queue_capacity( ) const noexcept
+{
+    return queue.size();
+}
+
+inline void ThreadPool::set_error_stream(std::ostream& stream) noexcept
+{
+    error_stream = &stream;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
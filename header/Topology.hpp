@@ -0,0 +1,147 @@
+/*
+ * \file Topology.hpp
+ * \brief Header file de::Koesling::Threading::Topology
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include "CpuSet.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief CPU topology of the system (online CPUs)
+ *
+ * Only the online CPUs the calling thread may run on are used (sched_getaffinity), so a cgroup cpuset (e.g. of a
+ * container) or taskset restricts the topology.
+ *
+ * Reads /sys/devices/system/cpu and /sys/devices/system/node and groups the online CPUs by
+ *      - physical core (SMT siblings)
+ *      - L3 cache domain (CPUs that share a L3 cache)
+ *      - NUMA node
+ *
+ * Missing information (e.g. hidden in containers) is replaced by the next coarser level: one core per CPU, one L3
+ * domain per package, one NUMA node for all CPUs.
+ *
+ * The topology is read once by the constructor. The result of place() can be passed to Thread::set_affinity().
+ */
+class Topology final
+{
+    public:
+        //! placement of threads
+        enum placement_t
+        {
+            PER_CPU,    //!< one logical CPU per thread
+            PER_CORE,   //!< one physical core (all SMT siblings) per thread
+            PER_L3,     //!< one L3 cache domain per thread
+            PER_NODE    //!< one NUMA node per thread
+        };
+
+    private:
+        //! all online CPUs the calling thread of the constructor may run on
+        CpuSet online;
+
+        //! online CPUs, one set per CPU
+        std::vector<CpuSet> cpus;
+
+        //! online CPUs, one set per physical core
+        std::vector<CpuSet> cores;
+
+        //! online CPUs, one set per L3 cache domain
+        std::vector<CpuSet> l3_domains;
+
+        //! online CPUs, one set per NUMA node (only nodes with online CPUs)
+        std::vector<CpuSet> nodes;
+
+        //! add set (restricted to the online CPUs) to groups if it is not empty and not already contained
+        void add_group(std::vector<CpuSet> &groups, const CpuSet &set) const;
+
+    public:
+        /*! Read the topology of the system
+         *
+         * possible throws:
+         *      - std::bad_alloc: out of memory
+         */
+        Topology( );
+
+        //! get all online CPUs (restricted to the affinity of the thread that created the object)
+        inline const CpuSet& get_online( ) const noexcept;
+
+        //! get the online CPUs, one set per CPU
+        inline const std::vector<CpuSet>& get_cpus( ) const noexcept;
+
+        //! get the online CPUs, one set per physical core (SMT siblings)
+        inline const std::vector<CpuSet>& get_cores( ) const noexcept;
+
+        //! get the online CPUs, one set per L3 cache domain
+        inline const std::vector<CpuSet>& get_l3_domains( ) const noexcept;
+
+        //! get the online CPUs, one set per NUMA node
+        inline const std::vector<CpuSet>& get_nodes( ) const noexcept;
+
+        /*! get the groups for a placement
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid placement
+         */
+        const std::vector<CpuSet>& get_groups(placement_t placement) const;
+
+        /*! get the CPUs for a thread (round robin over the groups of the placement)
+         *
+         * Thread i is placed in group i % number of groups. Consecutive threads are placed in different groups.
+         *
+         * attributes:
+         *      - thread_index: index of the thread
+         *      - placement   : placement of the threads
+         *
+         * possible throws:
+         *      - std::invalid_argument: invalid placement
+         */
+        const CpuSet& place(std::size_t thread_index, placement_t placement) const;
+};
+
+inline const CpuSet& Topology::get_online( ) const noexcept
+{
+    return online;
+}
+
+inline const std::vector<CpuSet>& Topology::get_cpus( ) const noexcept
+{
+    return cpus;
+}
+
+inline const std::vector<CpuSet>& Topology::get_cores( ) const noexcept
+{
+    return cores;
+}
+
+inline const std::vector<CpuSet>& Topology::get_l3_domains( ) const noexcept
+{
+    return l3_domains;
+}
+
+inline const std::vector<CpuSet>& Topology::get_nodes( ) const noexcept
+{
+    return nodes;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
+
+#ifndef __EXCEPTIONS
+static_assert(false, "Exceptions are mandatory.");
+#endif
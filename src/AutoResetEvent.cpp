@@ -0,0 +1,129 @@
+/*
+ * \file AutoResetEvent.cpp
+ * \brief Source file de::Koesling::Threading::AutoResetEvent
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "AutoResetEvent.hpp"
+
+#include "futex.hpp"
+#include "pthread_timeout.hpp"
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+AutoResetEvent::AutoResetEvent(bool initial_state) noexcept :
+        state(initial_state ? 1 : 0),
+        waiters(0)
+{ }
+
+AutoResetEvent::AutoResetEvent(AutoResetEvent &&other) noexcept :
+        state(other.state.load(std::memory_order_relaxed)),
+        waiters(other.waiters.load(std::memory_order_relaxed))
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+AutoResetEvent& AutoResetEvent::operator=(AutoResetEvent &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        this->state.store(other.state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        this->waiters.store(other.waiters.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    return *this;
+}
+
+void AutoResetEvent::wait( )
+{
+    if (try_acquire()) return;
+
+    // announce the waiting thread before checking the state again, so set() can not miss it
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    while (!try_acquire())
+    {
+        try
+        {
+            futex_wait(state, 0);
+        }
+        catch (...)
+        {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool AutoResetEvent::trywait( ) noexcept
+{
+    return try_acquire();
+}
+
+bool AutoResetEvent::timedwait(const timespec &time)
+{
+    // the timeout is also verified if the event is set
+    const timespec timeout_time = monotonic_timeout(time);
+
+    if (try_acquire()) return true;
+
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    bool return_value = true;
+    while (!try_acquire())
+    {
+        bool no_timeout;
+        try
+        {
+            no_timeout = futex_wait(state, 0, &timeout_time);
+        }
+        catch (...)
+        {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+
+        if (!no_timeout)
+        {
+            // last attempt: the event could have been set right before the timeout expired
+            return_value = try_acquire();
+            break;
+        }
+    }
+
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+
+    return return_value;
+}
+
+void AutoResetEvent::set( )
+{
+    state.store(1, std::memory_order_seq_cst);
+
+    // system call only if there are suspended threads
+    if (waiters.load(std::memory_order_seq_cst) > 0) futex_wake(state, 1);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
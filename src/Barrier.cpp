@@ -0,0 +1,136 @@
+/*
+ * \file Barrier.cpp
+ * \brief Source file de::Koesling::Threading::Barrier
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "Barrier.hpp"
+
+#include "futex.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Barrier::Barrier(unsigned int count, completion_function_t completion) :
+        remaining(static_cast<int>(count)),
+        sense(0),
+        waiters(0),
+        thread_count(static_cast<int>(count)),
+        completion(std::move(completion))
+{
+    if(!count) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": a barrier for 0 threads is pointless.");
+
+    if(count > INT_MAX) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": count must not be larger than INT_MAX.");
+}
+
+Barrier::Barrier(Barrier &&other) noexcept :
+        remaining(other.remaining.load(std::memory_order_relaxed)),
+        sense(other.sense.load(std::memory_order_relaxed)),
+        waiters(other.waiters.load(std::memory_order_relaxed)),
+        thread_count(other.thread_count),
+        completion(std::move(other.completion))
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Barrier& Barrier::operator=(Barrier &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        this->remaining.store(other.remaining.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        this->sense.store(other.sense.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        this->waiters.store(other.waiters.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        this->thread_count = other.thread_count;
+        this->completion = std::move(other.completion);
+    }
+
+    return *this;
+}
+
+void Barrier::release(int new_sense)
+{
+    // reset the barrier before the sense is flipped: released threads may arrive for the next phase immediately
+    remaining.store(thread_count, std::memory_order_relaxed);
+    sense.store(new_sense, std::memory_order_seq_cst);
+
+    // system call only if there are suspended threads
+    if (waiters.load(std::memory_order_seq_cst) > 0) futex_wake(sense, INT_MAX);
+}
+
+bool Barrier::arrive_and_wait( )
+{
+    // the sense can not change before this thread arrived
+    const int local_sense = sense.load(std::memory_order_acquire);
+
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // last arriving thread: complete the phase, the other threads are released even if the completion fails
+        try
+        {
+            if (completion) completion();
+        }
+        catch (...)
+        {
+            release(local_sense ^ 1);
+            throw;
+        }
+
+        release(local_sense ^ 1);
+        return true;
+    }
+
+    // spin briefly, the phases of a barrier are usually short
+    for (unsigned int i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (sense.load(std::memory_order_acquire) != local_sense) return false;
+        cpu_relax();
+    }
+
+    // announce the waiting thread before checking the sense again, so the last thread can not miss it
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    try
+    {
+        while (sense.load(std::memory_order_acquire) == local_sense)
+            futex_wait(sense, local_sense);
+    }
+    catch (...)
+    {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+
+    return false;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
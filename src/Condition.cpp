@@ -17,6 +17,7 @@
 // ---------------------------------------------------------------------------------------------------------------------
 #include "Condition.hpp"
 
+#include "futex.hpp"
 #include "pthread_timeout.hpp"
 #include "sysexcept.hpp"
 #include "destructor_exception.hpp"
@@ -24,9 +25,10 @@
 
 // -------------------- standard library includes ----------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
+#include <algorithm>
 #include <stdexcept>
 #include <cerrno>
-#include <sys/time.h>
+#include <limits>
 #include <iostream>
 #include <sysexits.h>
 
@@ -44,26 +46,42 @@ std::ostream* Condition::error_stream = &std::cerr;
 // -------------------- Constructor(s) ---------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
-// ignore old style cast, because PTHREAD_COND_INITIALIZER uses one
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
 Condition::Condition( ) noexcept :
-        mutex( PTHREAD_MUTEX_INITIALIZER),
-        condition(PTHREAD_COND_INITIALIZER),
-        signal_created(false),
+        lock_word(0),
+        head(nullptr),
+        tail(nullptr),
+        free_groups(nullptr),
         waiting_thread_count(0),
-        wakeup_by_brodcast(false)
+        clock(CLOCK_REALTIME)
 { }
-// re-enable warnings
-#pragma GCC diagnostic pop
+
+Condition::Condition(clockid_t clock) :
+        lock_word(0),
+        head(nullptr),
+        tail(nullptr),
+        free_groups(nullptr),
+        waiting_thread_count(0),
+        clock(clock)
+{
+    // the futex system call supports only these clocks
+    if (clock != CLOCK_REALTIME && clock != CLOCK_MONOTONIC)
+        throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+                ": only CLOCK_REALTIME and CLOCK_MONOTONIC are supported.");
+}
 
 Condition::Condition(Condition &&other) noexcept :
-        mutex(std::move(other.mutex)),
-        condition(std::move(other.condition)),
-        signal_created(std::move(other.signal_created)),
-        waiting_thread_count(std::move(other.waiting_thread_count)),
-        wakeup_by_brodcast(std::move(other.wakeup_by_brodcast))
-{ }
+        lock_word(other.lock_word.load( )),
+        head(other.head),
+        tail(other.tail),
+        free_groups(other.free_groups),
+        waiting_thread_count(other.waiting_thread_count),
+        clock(other.clock)
+{
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.free_groups = nullptr;
+    other.waiting_thread_count = 0;
+}
 
 
 // -------------------- Destructor -------------------------------------------------------------------------------------
@@ -71,18 +89,18 @@ Condition::Condition(Condition &&other) noexcept :
 
 Condition::~Condition( )
 {
-    try
+    // there is no kernel object to destroy, but waiting threads would access freed memory
+    if (waiting_thread_count != 0)
     {
-        int temp = pthread_cond_destroy(&condition);
-        sysexcept(temp != 0, "pthread_cond_destroy", temp);
-
-        temp = pthread_mutex_destroy(&mutex);
-        sysexcept(temp != 0, "pthread_mutex_destroy", temp);
+        std::logic_error e(std::string(__PRETTY_FUNCTION__) + ": Condition destroyed while threads are waiting.");
+        destructor_exception_terminate(e, *error_stream, EX_SOFTWARE);
     }
-    catch (const std::system_error &e)
+
+    while (free_groups)
     {
-        // failed to destroy mutex/condition --> major error --> terminate
-        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+        group_t *group = free_groups;
+        free_groups = group->next;
+        delete group;
     }
 }
 
@@ -95,129 +113,328 @@ noexcept
 {
     if (this != &other) // check for self assignment
     {
-        this->mutex = std::move(other.mutex);
-        this->condition = std::move(other.condition);
-        this->signal_created = std::move(other.signal_created);
-        this->waiting_thread_count = std::move(other.waiting_thread_count);
-        this->wakeup_by_brodcast = std::move(other.wakeup_by_brodcast);
+        while (free_groups)
+        {
+            group_t *group = free_groups;
+            free_groups = group->next;
+            delete group;
+        }
+
+        this->lock_word = other.lock_word.load( );
+        this->head = other.head;
+        this->tail = other.tail;
+        this->free_groups = other.free_groups;
+        this->waiting_thread_count = other.waiting_thread_count;
+        this->clock = other.clock;
+
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.free_groups = nullptr;
+        other.waiting_thread_count = 0;
     }
 
     return *this;
 }
 
-bool Condition::wait( )
+Condition::group_t* Condition::join_group(bool own)
 {
-    // lock mutex (to avoid condition_signal/broadcast race condition)
-    int temp = pthread_mutex_lock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_lock", temp);
-
-    waiting_thread_count++;	// add waiting tread
+    group_t *group = tail;
 
-    while (!signal_created)
+    if (own || !group || !group->open)
     {
-        temp = pthread_cond_wait(&condition, &mutex);
-        sysexcept(temp != 0, "pthread_cond_wait", temp);
+        if (free_groups)
+        {
+            group = free_groups;
+            free_groups = group->next;
+        }
+        else
+        {
+            group = new group_t;
+            group->word.store(0, std::memory_order_relaxed);
+        }
+
+        group->waiting = 0;
+        group->restarts = 0;
+        group->members = 0;
+        group->open = !own;
+        group->interrupted = false;
+
+        // append to the list of groups
+        group->next = nullptr;
+        group->prev = tail;
+        if (tail) tail->next = group;
+        else head = group;
+        tail = group;
     }
 
-    waiting_thread_count--;	// remove waiting thread
+    group->waiting++;
+    group->members++;
+    return group;
+}
+
+void Condition::leave_group(group_t *group) noexcept
+{
+    if (--group->members != 0) return;
 
-    // only reset if no other thread can receive the signal
-    if (!wakeup_by_brodcast || waiting_thread_count == 0) signal_created = false;
+    if (group->prev) group->prev->next = group->next;
+    else head = group->next;
 
-    // unlock mutex
-    temp = pthread_mutex_unlock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+    if (group->next) group->next->prev = group->prev;
+    else tail = group->prev;
 
-    return true;
+    group->next = free_groups;
+    free_groups = group;
 }
 
-bool Condition::wait(const struct timespec &time)
+void Condition::interrupt(group_t *const &group)
 {
-    const struct timespec timeout_time = pthread_timeout(time);
+    futex_lock(lock_word);
 
-    // lock mutex (avoid condition_signal/broadcast race condition)
-    int temp = pthread_mutex_lock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_lock", temp);
+    // restart the thread, unless it was restarted by notify() or is not waiting (anymore)
+    if (group && group->waiting != 0)
+    {
+        group->waiting--;
+        group->interrupted = true;
+        group->word.fetch_add(1, std::memory_order_release);
+        futex_wake(group->word, 1);
+    }
+
+    futex_unlock(lock_word);
+}
 
-    waiting_thread_count++; // add waiting tread
+bool Condition::suspend(Mutex *mutex, const struct timespec *timeout_time, bool realtime, const StopToken *token)
+{
+    // registered before the internal lock is locked: the callback locks it
+    group_t *group = nullptr;
+    auto restart = [this, &group]( ) { interrupt(group); };
+    StopCallback<decltype(restart)> stop_callback(token ? *token : StopToken( ), restart);
+
+    // lock internal lock (to avoid condition_signal/broadcast race condition)
+    futex_lock(lock_word);
+
+    // a stop requested before the callback was registered: do not wait
+    if (token && token->stop_requested( ))
+    {
+        futex_unlock(lock_word);
+        if (mutex)
+        {
+            mutex->locked = false;
+            int temp = pthread_mutex_unlock(&mutex->mutex);
+            if (temp != 0) mutex->locked = true;
+            sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+        }
+        return true;
+    }
+
+    // a stop request must wake only this thread: stop aware waits do not share their group
+    try
+    {
+        group = join_group(token != nullptr);
+    }
+    catch (...)
+    {
+        futex_unlock(lock_word);
+        throw;
+    }
+    waiting_thread_count++;
 
-    bool return_value = true;
-    while (!signal_created)
+    if (mutex)
     {
-        temp = pthread_cond_timedwait(&condition, &mutex, &timeout_time);
+        mutex->locked = false;
+        int temp = pthread_mutex_unlock(&mutex->mutex);
         if (temp != 0)
         {
-            if (temp == ETIMEDOUT)
+            mutex->locked = true;
+            group->waiting--;
+            leave_group(group);
+            group = nullptr;
+            waiting_thread_count--;
+            futex_unlock(lock_word);
+            sysexcept(true, "pthread_mutex_unlock", temp);
+        }
+    }
+
+    // notify() changes the futex word before the thread is woken, so a restart can not be lost
+    int expected = group->word.load(std::memory_order_relaxed);
+    futex_unlock(lock_word);
+
+    bool restarted = false;
+    bool no_timeout = true;
+    for (;;)
+    {
+        try
+        {
+            no_timeout = futex_wait(group->word, expected, timeout_time, realtime);
+        }
+        catch (...)
+        {
+            futex_lock(lock_word);
+            if (group->restarts != 0 && group->waiting == 0)
+            {
+                // all remaining members were restarted: this thread takes a restart
+                group->restarts--;
+            }
+            else if (!group->interrupted)
             {
-                return_value = false;
-                break;
+                group->waiting--;
+
+                // this thread might have been the one that was woken for a restart: wake another member
+                if (group->restarts != 0)
+                {
+                    group->word.fetch_add(1, std::memory_order_release);
+                    futex_wake(group->word, 1);
+                }
             }
-            else sysexcept(true, "pthread_cond_timedwait", temp);
+            leave_group(group);
+            group = nullptr;
+            waiting_thread_count--;
+            futex_unlock(lock_word);
+            throw;
         }
+
+        // The thread might have been requeued to the internal lock: the next waiter is woken on unlock.
+        futex_lock_contended(lock_word);
+
+        // a restart that arrived together with the timeout is consumed anyway
+        if (group->restarts != 0)
+        {
+            group->restarts--;
+            restarted = true;
+            break;
+        }
+
+        if (group->interrupted)
+        {
+            restarted = true;
+            break;
+        }
+
+        if (!no_timeout)
+        {
+            group->waiting--;
+            break;
+        }
+
+        // woken for a restart that was consumed by another member of the group (or by a signal)
+        expected = group->word.load(std::memory_order_relaxed);
+        futex_unlock(lock_word);
     }
 
-    waiting_thread_count--; // remove waiting thread
+    leave_group(group);
+    group = nullptr;
+    waiting_thread_count--;
 
-    // only reset if no other thread can receive the signal
-    if (!wakeup_by_brodcast || waiting_thread_count == 0) signal_created = false;
+    futex_unlock(lock_word);
 
-    // unlock mutex
-    temp = pthread_mutex_unlock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+    return restarted;
+}
 
-    return return_value;
+bool Condition::wait( )
+{
+    return suspend(nullptr, nullptr, false);
 }
 
-bool Condition::signal( )
+bool Condition::wait(const struct timespec &time)
 {
-    // lock mutex (avoid condition_wait race condition)
-    int temp = pthread_mutex_lock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_lock", temp);
+    const struct timespec timeout_time = monotonic_timeout(time);
+    return suspend(nullptr, &timeout_time, false);
+}
 
-    // no thread waiting ? --> no signal created
-    signal_created = waiting_thread_count != 0;
-    wakeup_by_brodcast = false;
+bool Condition::wait_until(const struct timespec &deadline)
+{
+    return suspend(nullptr, &deadline, clock == CLOCK_REALTIME);
+}
 
-    /* buffer the return value, because 'signal_created' could be reset (to false) by the
-     * signaled thread before this function is completed.
-     */
-    bool ret_val = signal_created;
+bool Condition::wait_once(Mutex &mutex, const struct timespec *timeout_time, bool realtime, const StopToken *token)
+{
+    // the mutex is released while waiting, therefore it must be owned by the calling thread
+    if (!mutex.locked || mutex.lock_thread != pthread_self( ))
+        throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                ": The Mutex must be locked by the calling thread.");
 
-    // signal condition (wake exactly one thread)
-    temp = pthread_cond_signal(&condition);
-    sysexcept(temp != 0, "pthread_cond_signal", temp);
+    bool restarted;
+    try
+    {
+        restarted = suspend(&mutex, timeout_time, realtime, token);
+    }
+    catch (...)
+    {
+        if (!mutex.locked)
+        {
+            pthread_mutex_lock(&mutex.mutex);
+            mutex.lock_thread = pthread_self( );
+            mutex.locked = true;
+        }
+        throw;
+    }
+
+    // the internal lock is already released: a signaling thread might hold the mutex while it calls notify
+    int temp = pthread_mutex_lock(&mutex.mutex);
+    sysexcept(temp != 0, "pthread_mutex_lock", temp);
 
-    // unlock mutex
-    temp = pthread_mutex_unlock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+    mutex.lock_thread = pthread_self( );
+    mutex.locked = true;
 
-    return ret_val;
+    return restarted;
 }
 
-bool Condition::broadcast( )
+struct timespec Condition::timeout(const struct timespec &time)
 {
-    // lock mutex (avoid condition_wait race condition)
-    int temp = pthread_mutex_lock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_lock", temp);
+    return monotonic_timeout(time);
+}
+
+bool Condition::signal( )
+{
+    return notify(1) != 0;
+}
+
+size_t Condition::notify(size_t n)
+{
+    // lock internal lock (avoid condition_wait race condition)
+    futex_lock(lock_word);
+
+    size_t count = 0;
+    try
+    {
+        // restart the threads that wait the longest
+        for (group_t *group = head; group && count < n; group = group->next)
+        {
+            if (group->waiting == 0) continue;
 
-    // no thread waiting ? --> no signal created
-    signal_created = waiting_thread_count != 0;
-    wakeup_by_brodcast = true;
+            size_t restarts = std::min(n - count, group->waiting);
+            restarts = std::min(restarts, static_cast<size_t>(std::numeric_limits<int>::max( )));
 
-    /* buffer the return value, since 'signal_created' could be changed by the
-     * signaled thread before this function is completed.
-     */
-    bool ret_val = signal_created;
+            group->waiting -= restarts;
+            group->restarts += restarts;
 
-    // broadcast condition (wake all threads)
-    temp = pthread_cond_broadcast(&condition);
-    sysexcept(temp != 0, "pthread_cond_broadcast", temp);
+            // threads that start waiting from now on must not be restarted by this call
+            group->open = false;
+            const int word = group->word.fetch_add(1, std::memory_order_release) + 1;
 
-    // unlock mutex
-    temp = pthread_mutex_unlock(&mutex);
-    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+            // Wait morphing: the threads are not woken up (they would block on the internal lock that is held by
+            // this thread), but moved to the futex of the internal lock with one system call per group. Each
+            // thread that releases the internal lock wakes the next one. The lock word is marked as contended, so
+            // that the unlock below wakes the first thread. Members that did not sleep yet see the changed word.
+            lock_word.store(2, std::memory_order_relaxed);
+            futex_requeue(group->word, word, 0, static_cast<int>(restarts), lock_word);
 
-    return ret_val;
+            count += restarts;
+        }
+    }
+    catch (...)
+    {
+        futex_unlock(lock_word);
+        throw;
+    }
+
+    futex_unlock(lock_word);
+
+    return count;
+}
+
+bool Condition::broadcast( )
+{
+    return notify(std::numeric_limits<size_t>::max( )) != 0;
 }
 
 } /* namespace Threading */
@@ -0,0 +1,201 @@
+/*
+ * \file CpuSet.cpp
+ * \brief Source file de::Koesling::Threading::CpuSet
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "CpuSet.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+
+// -------------------- error messages ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+//! error message: cpu number out of range
+#define CPU_OUT_OF_RANGE std::string(__PRETTY_FUNCTION__) + ": CPU " + std::to_string(cpu) + " is out of range " \
+    "(maximum: " + std::to_string(CPU_SETSIZE - 1) + ")."
+
+//! error message: invalid cpu list
+#define INVALID_LIST std::string(__PRETTY_FUNCTION__) + ": Invalid CPU list: '" + list + "'."
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+CpuSet::CpuSet( ) noexcept
+{
+    CPU_ZERO(&set);
+}
+
+CpuSet::CpuSet(std::initializer_list<unsigned int> cpus) :
+        CpuSet()
+{
+    for (auto cpu : cpus)
+        add(cpu);
+}
+
+CpuSet::CpuSet(const std::vector<unsigned int> &cpus) :
+        CpuSet()
+{
+    for (auto cpu : cpus)
+        add(cpu);
+}
+
+CpuSet::CpuSet(const cpu_set_t &set) noexcept :
+        set(set)
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+void CpuSet::check_cpu(unsigned int cpu)
+{
+    if (cpu >= CPU_SETSIZE) throw std::invalid_argument(CPU_OUT_OF_RANGE);
+}
+
+CpuSet CpuSet::from_list(const std::string &list)
+{
+    CpuSet result;
+
+    std::size_t pos = 0;
+    while (pos < list.size())
+    {
+        // skip separators and whitespace (sysfs files end with a newline)
+        if (list[pos] == ',' || std::isspace(static_cast<unsigned char>(list[pos])))
+        {
+            pos++;
+            continue;
+        }
+
+        if (!std::isdigit(static_cast<unsigned char>(list[pos]))) throw std::invalid_argument(INVALID_LIST);
+
+        std::size_t length;
+        const unsigned long first = std::stoul(list.substr(pos), &length);
+        pos += length;
+
+        unsigned long last = first;
+        if (pos < list.size() && list[pos] == '-')
+        {
+            pos++;
+            if (pos >= list.size() || !std::isdigit(static_cast<unsigned char>(list[pos])))
+                throw std::invalid_argument(INVALID_LIST);
+
+            last = std::stoul(list.substr(pos), &length);
+            pos += length;
+        }
+
+        if (last < first || last >= CPU_SETSIZE) throw std::invalid_argument(INVALID_LIST);
+
+        for (unsigned long cpu = first; cpu <= last; ++cpu)
+            CPU_SET(cpu, &result.set);
+    }
+
+    return result;
+}
+
+void CpuSet::add(unsigned int cpu)
+{
+    check_cpu(cpu);
+    CPU_SET(cpu, &set);
+}
+
+void CpuSet::remove(unsigned int cpu)
+{
+    check_cpu(cpu);
+    CPU_CLR(cpu, &set);
+}
+
+bool CpuSet::contains(unsigned int cpu) const noexcept
+{
+    return cpu < CPU_SETSIZE && CPU_ISSET(cpu, &set);
+}
+
+std::size_t CpuSet::count( ) const noexcept
+{
+    return static_cast<std::size_t>(CPU_COUNT(&set));
+}
+
+std::vector<unsigned int> CpuSet::get_cpus( ) const
+{
+    std::vector<unsigned int> cpus;
+    for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    return cpus;
+}
+
+std::string CpuSet::to_list( ) const
+{
+    std::ostringstream list;
+
+    unsigned int cpu = 0;
+    while (cpu < CPU_SETSIZE)
+    {
+        if (!CPU_ISSET(cpu, &set))
+        {
+            cpu++;
+            continue;
+        }
+
+        // range of consecutive CPUs
+        const unsigned int first = cpu;
+        while (cpu + 1 < CPU_SETSIZE && CPU_ISSET(cpu + 1, &set))
+            cpu++;
+
+        if (list.tellp() > 0) list << ',';
+        list << first;
+        if (cpu != first) list << '-' << cpu;
+        cpu++;
+    }
+
+    return list.str();
+}
+
+CpuSet CpuSet::operator|(const CpuSet &other) const noexcept
+{
+    CpuSet result;
+    CPU_OR(&result.set, &set, &other.set);
+    return result;
+}
+
+CpuSet CpuSet::operator&(const CpuSet &other) const noexcept
+{
+    CpuSet result;
+    CPU_AND(&result.set, &set, &other.set);
+    return result;
+}
+
+bool CpuSet::operator==(const CpuSet &other) const noexcept
+{
+    return CPU_EQUAL(&set, &other.set);
+}
+
+std::ostream& operator <<(std::ostream &os, const CpuSet &set)
+{
+    os << set.to_list();
+    return os;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,108 @@
+/*
+ * \file EventCount.cpp
+ * \brief Source file de::Koesling::Threading::EventCount
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "EventCount.hpp"
+
+#include "futex.hpp"
+#include "pthread_timeout.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+EventCount::EventCount( ) noexcept :
+        epoch(0),
+        waiters(0)
+{ }
+
+EventCount::EventCount(EventCount &&other) noexcept :
+        epoch(other.epoch.load(std::memory_order_relaxed)),
+        waiters(other.waiters.load(std::memory_order_relaxed))
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+EventCount& EventCount::operator=(EventCount &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        this->epoch.store(other.epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        this->waiters.store(other.waiters.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    return *this;
+}
+
+void EventCount::wait(wait_key_t key)
+{
+    try
+    {
+        // the futex compares the epoch with the key: a notification after prepare_wait() is not lost
+        while (epoch.load(std::memory_order_acquire) == key)
+            futex_wait(epoch, key);
+    }
+    catch (...)
+    {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool EventCount::wait(wait_key_t key, const timespec &time)
+{
+    bool no_timeout = true;
+    try
+    {
+        // an invalid time span throws: the thread is no longer counted as waiting
+        const timespec timeout_time = monotonic_timeout(time);
+
+        while (epoch.load(std::memory_order_acquire) == key && no_timeout)
+            no_timeout = futex_wait(epoch, key, &timeout_time);
+    }
+    catch (...)
+    {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+
+    // a notification that arrived together with the timeout is reported anyway
+    return epoch.load(std::memory_order_acquire) != key;
+}
+
+void EventCount::wake(int count)
+{
+    epoch.fetch_add(1, std::memory_order_seq_cst);
+    futex_wake(epoch, count < 0 ? INT_MAX : count);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
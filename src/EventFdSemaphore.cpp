@@ -0,0 +1,185 @@
+/*
+ * \file EventFdSemaphore.cpp
+ * \brief Source file de::Koesling::Threading::EventFdSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "EventFdSemaphore.hpp"
+
+#include "pthread_timeout.hpp"
+#include "sysexcept.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cerrno>
+#include <cstdint>
+#include <iostream>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sysexits.h>
+#include <unistd.h>
+
+
+// -------------------- General constants and definitions --------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#define NSEC_PER_SEC 1000000000
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* EventFdSemaphore::error_stream = &std::cerr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+EventFdSemaphore::EventFdSemaphore(unsigned int value) :
+        fd(eventfd(value, EFD_SEMAPHORE | EFD_NONBLOCK | EFD_CLOEXEC))
+{
+    sysexcept(fd < 0, "eventfd", errno);
+}
+
+EventFdSemaphore::EventFdSemaphore(EventFdSemaphore &&other) noexcept :
+        fd(other.fd)
+{
+    other.fd = -1;
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+EventFdSemaphore::~EventFdSemaphore( )
+{
+    if (fd < 0) return; // moved
+
+    try
+    {
+        sysexcept(close(fd), "close", errno);
+    }
+    catch (const std::system_error& e)
+    {
+        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+EventFdSemaphore& EventFdSemaphore::operator=(EventFdSemaphore &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        if (fd >= 0) close(fd);
+
+        this->fd = other.fd;
+        other.fd = -1;
+    }
+
+    return *this;
+}
+
+void EventFdSemaphore::wait( )
+{
+    while (!trywait())
+        poll_readable(nullptr);
+}
+
+bool EventFdSemaphore::trywait( )
+{
+    // EFD_SEMAPHORE: a successful read decrements the value by one
+    uint64_t value;
+    ssize_t temp;
+    do temp = read(fd, &value, sizeof(value));
+    while (temp < 0 && errno == EINTR);
+
+    if (temp < 0)
+    {
+        if (errno == EAGAIN) return false;
+        sysexcept(true, "read", errno);
+    }
+
+    return true;
+}
+
+bool EventFdSemaphore::timedwait(const timespec &time)
+{
+    const timespec timeout_time = monotonic_timeout(time);
+
+    while (!trywait())
+    {
+        // last attempt if the timeout expired: the semaphore could have been posted in the meantime
+        if (!poll_readable(&timeout_time)) return trywait();
+    }
+
+    return true;
+}
+
+void EventFdSemaphore::post(unsigned int n)
+{
+    uint64_t value = n;
+    ssize_t temp;
+    do temp = write(fd, &value, sizeof(value));
+    while (temp < 0 && errno == EINTR);
+
+    sysexcept(temp < 0, "write", errno);
+}
+
+bool EventFdSemaphore::poll_readable(const timespec *timeout_time)
+{
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+
+    while (true)
+    {
+        struct timespec remaining;
+        if (timeout_time)
+        {
+            struct timespec now;
+            sysexcept(clock_gettime(CLOCK_MONOTONIC, &now), "clock_gettime", errno);
+
+            remaining.tv_sec = timeout_time->tv_sec - now.tv_sec;
+            remaining.tv_nsec = timeout_time->tv_nsec - now.tv_nsec;
+            if (remaining.tv_nsec < 0)
+            {
+                remaining.tv_sec--;
+                remaining.tv_nsec += NSEC_PER_SEC;
+            }
+
+            if (remaining.tv_sec < 0) return false;
+        }
+
+        pfd.revents = 0;
+        int temp = ppoll(&pfd, 1, timeout_time ? &remaining : nullptr, nullptr);
+        if (temp < 0)
+        {
+            if (errno == EINTR) continue;
+            sysexcept(true, "ppoll", errno);
+        }
+
+        return temp != 0;
+    }
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,166 @@
+/*
+ * \file Future.cpp
+ * \brief Source file de::Koesling::Threading::future_internal::shared_state_base
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "Future.hpp"
+
+#include "futex.hpp"
+#include "pthread_timeout.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+namespace future_internal {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+shared_state_base::shared_state_base( ) noexcept :
+        state(PENDING),
+        satisfied(false),
+        lock_word(0)
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+void shared_state_base::claim( )
+{
+    if (satisfied.exchange(true, std::memory_order_relaxed))
+        throw std::future_error(std::future_errc::promise_already_satisfied);
+}
+
+void shared_state_base::make_ready( )
+{
+    // the continuations are taken under the lock, so add_continuation either stores one before or sees READY
+    futex_lock(lock_word);
+    std::vector<std::function<void()>> functions;
+    functions.swap(continuations);
+    const int old_state = state.exchange(READY, std::memory_order_acq_rel);
+    futex_unlock(lock_word);
+
+    if (old_state == WAITING) futex_wake(state, INT_MAX);
+
+    // a failing continuation must not prevent the others (e.g. of other futures) from being executed
+    std::exception_ptr first_exception;
+    for (auto &function : functions)
+    {
+        try
+        {
+            function();
+        }
+        catch (...)
+        {
+            if (!first_exception) first_exception = std::current_exception();
+        }
+    }
+
+    if (first_exception) std::rethrow_exception(first_exception);
+}
+
+void shared_state_base::fail(std::exception_ptr exception)
+{
+    this->exception = exception;
+    make_ready();
+}
+
+void shared_state_base::set_exception(std::exception_ptr exception)
+{
+    claim();
+    fail(exception);
+}
+
+void shared_state_base::wait( )
+{
+    int value = state.load(std::memory_order_acquire);
+    while (value != READY)
+    {
+        if (value == PENDING && !state.compare_exchange_weak(value, WAITING, std::memory_order_acquire,
+                std::memory_order_acquire))
+            continue;
+
+        futex_wait(state, WAITING);
+        value = state.load(std::memory_order_acquire);
+    }
+}
+
+bool shared_state_base::wait_for(const timespec &time)
+{
+    const timespec deadline = monotonic_timeout(time);
+
+    int value = state.load(std::memory_order_acquire);
+    while (value != READY)
+    {
+        if (value == PENDING && !state.compare_exchange_weak(value, WAITING, std::memory_order_acquire,
+                std::memory_order_acquire))
+            continue;
+
+        if (!futex_wait(state, WAITING, &deadline)) return is_ready();
+        value = state.load(std::memory_order_acquire);
+    }
+
+    return true;
+}
+
+bool shared_state_base::is_ready( ) const noexcept
+{
+    return state.load(std::memory_order_acquire) == READY;
+}
+
+bool shared_state_base::is_satisfied( ) const noexcept
+{
+    return satisfied.load(std::memory_order_relaxed);
+}
+
+void shared_state_base::rethrow( ) const
+{
+    if (exception) std::rethrow_exception(exception);
+}
+
+void shared_state_base::add_continuation(std::function<void()> function)
+{
+    futex_lock(lock_word);
+
+    if (state.load(std::memory_order_acquire) == READY)
+    {
+        futex_unlock(lock_word);
+        function();
+        return;
+    }
+
+    try
+    {
+        continuations.push_back(std::move(function));
+    }
+    catch (...)
+    {
+        futex_unlock(lock_word);
+        throw;
+    }
+    futex_unlock(lock_word);
+}
+
+} /* namespace future_internal */
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,119 @@
+/*
+ * \file Latch.cpp
+ * \brief Source file de::Koesling::Threading::Latch
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "Latch.hpp"
+
+#include "futex.hpp"
+#include "pthread_timeout.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Latch::Latch(unsigned int count) :
+        count(static_cast<int>(count))
+{
+    if(count > INT_MAX) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": count must not be larger than INT_MAX.");
+}
+
+Latch::Latch(Latch &&other) noexcept :
+        count(other.count.load(std::memory_order_relaxed))
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Latch& Latch::operator=(Latch &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+        this->count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return *this;
+}
+
+void Latch::count_down(unsigned int n)
+{
+    int value = count.load(std::memory_order_relaxed);
+    do
+    {
+        if (n > static_cast<unsigned int>(value))
+            throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                    ": The latch can not be counted down below zero.");
+    }
+    while (!count.compare_exchange_weak(value, value - static_cast<int>(n), std::memory_order_release,
+            std::memory_order_relaxed));
+
+    // only the thread that reached zero releases the waiting threads
+    if (n != 0 && static_cast<unsigned int>(value) == n) futex_wake(count, INT_MAX);
+}
+
+void Latch::wait( )
+{
+    // spin briefly, the last threads usually arrive within a short time
+    for (unsigned int i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (try_wait()) return;
+        cpu_relax();
+    }
+
+    int value;
+    while ((value = count.load(std::memory_order_acquire)) != 0)
+        futex_wait(count, value);
+}
+
+bool Latch::timedwait(const timespec &time)
+{
+    // the timeout is also verified if the counter already reached zero
+    const timespec timeout_time = monotonic_timeout(time);
+
+    for (unsigned int i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (try_wait()) return true;
+        cpu_relax();
+    }
+
+    int value;
+    while ((value = count.load(std::memory_order_acquire)) != 0)
+    {
+        // the counter could have reached zero right before the timeout expired
+        if (!futex_wait(count, value, &timeout_time)) return try_wait();
+    }
+
+    return true;
+}
+
+void Latch::arrive_and_wait(unsigned int n)
+{
+    count_down(n);
+    wait();
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,94 @@
+/*
+ * \file LightSemaphore.cpp
+ * \brief Source file de::Koesling::Threading::LightSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "LightSemaphore.hpp"
+
+#include "pthread_timeout.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+LightSemaphore::LightSemaphore(unsigned int value) :
+        count(static_cast<int>(value)),
+        max_value(value)
+{
+    if(!value) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": initializing a semaphore with maximum value of 0 is pointless.");
+
+    if(value > INT_MAX) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": maximum value must not be larger than INT_MAX.");
+}
+
+LightSemaphore::LightSemaphore(LightSemaphore &&other) noexcept :
+        count(std::move(other.count)),
+        max_value(other.max_value)
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+LightSemaphore& LightSemaphore::operator=(LightSemaphore &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        this->count = std::move(other.count);
+        this->max_value = other.max_value;
+    }
+
+    return *this;
+}
+
+void LightSemaphore::wait( )
+{
+    count.acquire(1, nullptr);
+}
+
+bool LightSemaphore::trywait( ) noexcept
+{
+    return count.try_acquire(1);
+}
+
+bool LightSemaphore::timedwait(const timespec &time)
+{
+    // the timeout is also verified if the semaphore is available
+    const timespec timeout_time = monotonic_timeout(time);
+
+    return count.acquire(1, &timeout_time);
+}
+
+void LightSemaphore::post( )
+{
+    if (!count.release(1, max_value))
+        throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                ": Releasing a semaphore which is not held is not allowed.");
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,130 @@
+/*
+ * \file ManualResetEvent.cpp
+ * \brief Source file de::Koesling::Threading::ManualResetEvent
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "ManualResetEvent.hpp"
+
+#include "futex.hpp"
+#include "pthread_timeout.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+ManualResetEvent::ManualResetEvent(bool initial_state) noexcept :
+        state(initial_state ? 1 : 0),
+        waiters(0)
+{ }
+
+ManualResetEvent::ManualResetEvent(ManualResetEvent &&other) noexcept :
+        state(other.state.load(std::memory_order_relaxed)),
+        waiters(other.waiters.load(std::memory_order_relaxed))
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+ManualResetEvent& ManualResetEvent::operator=(ManualResetEvent &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        this->state.store(other.state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        this->waiters.store(other.waiters.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    return *this;
+}
+
+void ManualResetEvent::wait( )
+{
+    if (state.load(std::memory_order_acquire) == 1) return;
+
+    // announce the waiting thread before checking the state again, so set() can not miss it
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    while (state.load(std::memory_order_seq_cst) != 1)
+    {
+        try
+        {
+            futex_wait(state, 0);
+        }
+        catch (...)
+        {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool ManualResetEvent::timedwait(const timespec &time)
+{
+    // the timeout is also verified if the event is set
+    const timespec timeout_time = monotonic_timeout(time);
+
+    if (state.load(std::memory_order_acquire) == 1) return true;
+
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    bool return_value = true;
+    while (state.load(std::memory_order_seq_cst) != 1)
+    {
+        bool no_timeout;
+        try
+        {
+            no_timeout = futex_wait(state, 0, &timeout_time);
+        }
+        catch (...)
+        {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+
+        if (!no_timeout)
+        {
+            // the event could have been set right before the timeout expired
+            return_value = state.load(std::memory_order_acquire) == 1;
+            break;
+        }
+    }
+
+    // a thread that timed out leaves nothing behind: the next set() does not perform a system call
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+
+    return return_value;
+}
+
+void ManualResetEvent::set( )
+{
+    state.store(1, std::memory_order_seq_cst);
+
+    // system call only if there are suspended threads
+    if (waiters.load(std::memory_order_seq_cst) > 0) futex_wake(state, INT_MAX);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
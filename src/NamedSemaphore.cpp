@@ -0,0 +1,174 @@
+/*
+ * \file NamedSemaphore.cpp
+ * \brief Source file de::Koesling::Threading::NamedSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "NamedSemaphore.hpp"
+
+#include "pthread_timeout.hpp"
+#include "sysexcept.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sysexits.h>
+#include <iostream>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* NamedSemaphore::error_stream = &std::cerr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+NamedSemaphore::NamedSemaphore(const std::string &name, unsigned int value, open_mode_t mode, mode_t permissions) :
+        sem(SEM_FAILED),
+        name(name)
+{
+    if(!value) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": initializing a semaphore with maximum value of 0 is pointless.");
+
+    int flags;
+    switch (mode)
+    {
+        case CREATE:
+            flags = O_CREAT | O_EXCL;
+            break;
+        case OPEN:
+            flags = 0;
+            break;
+        case CREATE_OR_OPEN:
+            flags = O_CREAT;
+            break;
+        default:
+            throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + ": invalid open mode.");
+    }
+
+    sem = sem_open(name.c_str(), flags, permissions, value);
+    sysexcept(sem == SEM_FAILED, "sem_open", errno);
+}
+
+NamedSemaphore::NamedSemaphore(const std::string &name) :
+        sem(sem_open(name.c_str(), 0)),
+        name(name)
+{
+    sysexcept(sem == SEM_FAILED, "sem_open", errno);
+}
+
+NamedSemaphore::NamedSemaphore(NamedSemaphore &&other) noexcept :
+        sem(other.sem),
+        name(std::move(other.name))
+{
+    other.sem = SEM_FAILED;
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+NamedSemaphore::~NamedSemaphore( )
+{
+    if (sem == SEM_FAILED) return; // moved
+
+    try
+    {
+        sysexcept(sem_close(sem), "sem_close", errno);
+    }
+    catch (const std::system_error& e)
+    {
+        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+NamedSemaphore& NamedSemaphore::operator=(NamedSemaphore &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+    {
+        if (sem != SEM_FAILED) sem_close(sem);
+
+        this->sem = other.sem;
+        this->name = std::move(other.name);
+        other.sem = SEM_FAILED;
+    }
+
+    return *this;
+}
+
+void NamedSemaphore::wait( )
+{
+    int temp;
+    do temp = sem_wait(sem);
+    while (temp && errno == EINTR);
+
+    sysexcept(temp, "sem_wait", errno);
+}
+
+bool NamedSemaphore::trywait( )
+{
+    if (sem_trywait(sem))
+    {
+        if (errno == EAGAIN) return false;
+        sysexcept(true, "sem_trywait", errno);
+    }
+
+    return true;
+}
+
+bool NamedSemaphore::timedwait(const timespec &time)
+{
+    return sem_wait_for(sem, time);
+}
+
+void NamedSemaphore::post( )
+{
+    sysexcept(sem_post(sem), "sem_post", errno);
+}
+
+unsigned int NamedSemaphore::get_value( )
+{
+    int value;
+    sysexcept(sem_getvalue(sem, &value), "sem_getvalue", errno);
+
+    // linux never reports the number of waiting threads as negative value
+    return value < 0 ? 0 : static_cast<unsigned int>(value);
+}
+
+void NamedSemaphore::unlink( )
+{
+    unlink(name);
+}
+
+void NamedSemaphore::unlink(const std::string &name)
+{
+    sysexcept(sem_unlink(name.c_str()), "sem_unlink", errno);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,80 @@
+/*
+ * \file Once.cpp
+ * \brief Source file de::Koesling::Threading::OnceFlag
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "Once.hpp"
+
+#include "futex.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+OnceFlag::OnceFlag( ) noexcept :
+        state(UNINITIALIZED)
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool OnceFlag::begin( )
+{
+    int value = state.load(std::memory_order_acquire);
+    while (value != DONE)
+    {
+        if (value == UNINITIALIZED)
+        {
+            if (state.compare_exchange_weak(value, RUNNING, std::memory_order_acquire, std::memory_order_acquire))
+                return true;
+            continue;
+        }
+
+        // mark the flag as waited for, so complete() wakes the suspended threads
+        if (value == RUNNING &&
+                !state.compare_exchange_weak(value, WAITING, std::memory_order_acquire, std::memory_order_acquire))
+            continue;
+
+        futex_wait(state, WAITING);
+        value = state.load(std::memory_order_acquire);
+    }
+
+    return false;
+}
+
+void OnceFlag::complete( )
+{
+    // system call only if there are suspended threads
+    if (state.exchange(DONE, std::memory_order_release) == WAITING) futex_wake(state, INT_MAX);
+}
+
+void OnceFlag::abort( )
+{
+    // all threads are woken, the first one executes the function, the others are suspended again
+    if (state.exchange(UNINITIALIZED, std::memory_order_release) == WAITING) futex_wake(state, INT_MAX);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
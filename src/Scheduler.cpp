@@ -0,0 +1,465 @@
+/*
+ * \file Scheduler.cpp
+ * \brief Source file de::Koesling::Threading::Scheduler and de::Koesling::Threading::TaskGroup
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "Scheduler.hpp"
+
+#include "futex.hpp"
+#include "work_stealing_deque.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <sched.h>
+#include <stdexcept>
+#include <string>
+#include <sysexits.h>
+#include <typeinfo>
+#include <unistd.h>
+
+
+// -------------------- error messages ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+//! error message: empty task
+#define EMPTY_TASK std::string(__PRETTY_FUNCTION__) + ": The task must not be empty."
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Internal types ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+struct Scheduler::task_t
+{
+    //! function of the task
+    task_function_t function;
+
+    //! group of the task, nullptr: submitted without group
+    TaskGroup *group;
+};
+
+struct Scheduler::worker_t
+{
+    //! tasks spawned by this worker
+    work_stealing_deque<task_t*> deque;
+
+    //! scheduler the worker belongs to
+    Scheduler *scheduler;
+
+    //! state of the random number generator (xorshift) used to select victims
+    std::uint64_t random_state;
+
+    //! next random number
+    std::uint64_t random( ) noexcept
+    {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 7;
+        random_state ^= random_state << 17;
+        return random_state;
+    }
+};
+
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* Scheduler::error_stream = &std::cerr;
+
+thread_local Scheduler::worker_t* Scheduler::this_worker = nullptr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Scheduler::Scheduler(unsigned int thread_count) :
+        thread_count(thread_count),
+        injection_count(0),
+        stopping(false)
+{
+    if (!this->thread_count)
+    {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        this->thread_count = processors > 0 ? static_cast<std::size_t>(processors) : 1;
+    }
+
+    worker_data.reset(new worker_t[this->thread_count]);
+    for (std::size_t i = 0; i < this->thread_count; ++i)
+    {
+        worker_data[i].scheduler = this;
+        worker_data[i].random_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+
+    workers.reserve(this->thread_count);
+
+    std::size_t started = 0;
+    try
+    {
+        for (std::size_t i = 0; i < this->thread_count; ++i)
+        {
+            workers.emplace_back([this, i]( ) { worker(i); });
+            workers.back().start();
+            started++;
+        }
+    }
+    catch (...)
+    {
+        // stop the workers that were already started (the destructor is not called)
+        stopping.store(true, std::memory_order_release);
+        idle_workers.notify_all();
+        for (std::size_t i = 0; i < started; ++i)
+            workers[i].join();
+        throw;
+    }
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Scheduler::~Scheduler( )
+{
+    try
+    {
+        // the workers terminate once they do not find any more tasks
+        stopping.store(true, std::memory_order_release);
+        idle_workers.notify_all();
+
+        for (auto &thread : workers)
+            thread.join();
+    }
+    catch (const std::system_error &e)
+    {
+        // worker threads might still access the object --> terminate
+        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Scheduler::worker_t* Scheduler::current_worker( ) const noexcept
+{
+    return this_worker && this_worker->scheduler == this ? this_worker : nullptr;
+}
+
+void Scheduler::worker(std::size_t index)
+{
+    worker_t &self = worker_data[index];
+    this_worker = &self;
+
+    while (true)
+    {
+        task_t *task = find_task(self);
+        if (!task)
+        {
+            // announce the idle worker before searching again, so a new task can not be missed
+            auto key = idle_workers.prepare_wait();
+
+            task = find_task(self);
+            if (!task)
+            {
+                if (stopping.load(std::memory_order_acquire))
+                {
+                    idle_workers.cancel_wait();
+                    break;
+                }
+
+                idle_workers.wait(key);
+                continue;
+            }
+
+            idle_workers.cancel_wait();
+        }
+
+        run(task);
+    }
+
+    this_worker = nullptr;
+}
+
+void Scheduler::schedule(task_t *task)
+{
+    worker_t *worker = current_worker();
+    if (worker)
+    {
+        // spawned by a worker: own deque, no synchronization with other workers
+        worker->deque.push(task);
+    }
+    else
+    {
+        injection_mutex.lock();
+        try
+        {
+            injection_queue.push_back(task);
+        }
+        catch (...)
+        {
+            injection_mutex.unlock();
+            throw;
+        }
+        injection_count.fetch_add(1, std::memory_order_release);
+        injection_mutex.unlock();
+    }
+
+    // system call only if a worker is suspended
+    idle_workers.notify();
+}
+
+Scheduler::task_t* Scheduler::take_injected( )
+{
+    if (injection_count.load(std::memory_order_acquire) == 0) return nullptr;
+
+    task_t *task = nullptr;
+    injection_mutex.lock();
+    if (!injection_queue.empty())
+    {
+        task = injection_queue.front();
+        injection_queue.pop_front();
+        injection_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    injection_mutex.unlock();
+
+    return task;
+}
+
+Scheduler::task_t* Scheduler::find_task(worker_t &worker)
+{
+    // youngest task of the own deque (LIFO)
+    task_t *task = worker.deque.take();
+    if (task) return task;
+
+    task = take_injected();
+    if (task) return task;
+
+    // steal the oldest task of another worker, starting at a random victim
+    const std::size_t start = worker.random() % thread_count;
+    for (std::size_t i = 0; i < thread_count; ++i)
+    {
+        worker_t &victim = worker_data[(start + i) % thread_count];
+        if (&victim == &worker) continue;
+
+        work_stealing_deque<task_t*>::steal_result_t result;
+        while ((result = victim.deque.steal(task)) == work_stealing_deque<task_t*>::ABORT)
+            cpu_relax();
+
+        if (result == work_stealing_deque<task_t*>::STOLEN) return task;
+    }
+
+    return nullptr;
+}
+
+void Scheduler::run(task_t *task) noexcept
+{
+    std::exception_ptr task_exception;
+    try
+    {
+        task->function();
+    }
+    catch (...)
+    {
+        task_exception = std::current_exception();
+    }
+
+    TaskGroup *group = task->group;
+    delete task;
+
+    if (group)
+    {
+        group->task_done(task_exception);
+    }
+    else if (task_exception)
+    {
+        try
+        {
+            std::rethrow_exception(task_exception);
+        }
+        catch (const std::exception &e)
+        {
+            *error_stream << __PRETTY_FUNCTION__ << ": Exception of type " << typeid(e).name()
+                    << " thrown by task:" << std::endl << "    " << e.what() << std::endl;
+        }
+        catch (...)
+        {
+            *error_stream << __PRETTY_FUNCTION__ << ": Unknown exception thrown by task." << std::endl;
+        }
+    }
+}
+
+Scheduler& Scheduler::get_default( )
+{
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+void Scheduler::submit(task_function_t task)
+{
+    if (!task) throw std::invalid_argument(EMPTY_TASK);
+
+    std::unique_ptr<task_t> new_task(new task_t{std::move(task), nullptr});
+    schedule(new_task.get());
+    new_task.release();
+}
+
+
+// -------------------- TaskGroup --------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+TaskGroup::TaskGroup(Scheduler &scheduler) noexcept :
+        scheduler(scheduler),
+        pending(0),
+        failed(false)
+{ }
+
+TaskGroup::~TaskGroup( )
+{
+    try
+    {
+        wait_pending();
+    }
+    catch (const std::system_error &e)
+    {
+        // tasks might still access the object --> terminate
+        destructor_exception_terminate(e, *Scheduler::error_stream, EX_OSERR);
+    }
+
+    if (failed.load(std::memory_order_acquire))
+    {
+        // exception was never passed to wait()
+        try
+        {
+            std::rethrow_exception(exception);
+        }
+        catch (const std::exception &e)
+        {
+            destructor_exception_continue(e, *Scheduler::error_stream);
+        }
+        catch (...)
+        {
+            *Scheduler::error_stream << __PRETTY_FUNCTION__ << ": Unknown exception thrown by task." << std::endl;
+        }
+    }
+}
+
+void TaskGroup::spawn(Scheduler::task_function_t task)
+{
+    if (!task) throw std::invalid_argument(EMPTY_TASK);
+
+    std::unique_ptr<Scheduler::task_t> new_task(new Scheduler::task_t{std::move(task), this});
+
+    pending.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        scheduler.schedule(new_task.get());
+    }
+    catch (...)
+    {
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+    new_task.release();
+}
+
+void TaskGroup::task_done(std::exception_ptr task_exception) noexcept
+{
+    // only the first exception is kept
+    if (task_exception && !failed.exchange(true, std::memory_order_relaxed)) exception = task_exception;
+
+    // wake the waiting thread if this was the last task
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == (WAITER_FLAG | 1))
+    {
+        try
+        {
+            futex_wake(pending, INT_MAX);
+        }
+        catch (const std::system_error &)
+        {
+            // the group might already be destroyed (the waiting thread was woken by a signal): nothing to wake up
+        }
+    }
+}
+
+void TaskGroup::wait_pending( )
+{
+    Scheduler::worker_t *worker = scheduler.current_worker();
+    if (worker)
+    {
+        // a worker must not be suspended: execute other tasks while the tasks of the group are executed
+        unsigned int spins = 0;
+        while ((pending.load(std::memory_order_acquire) & ~WAITER_FLAG) != 0)
+        {
+            Scheduler::task_t *task = scheduler.find_task(*worker);
+            if (task)
+            {
+                scheduler.run(task);
+                spins = 0;
+            }
+            else if (++spins < SPIN_COUNT)
+            {
+                cpu_relax();
+            }
+            else
+            {
+                sched_yield();
+            }
+        }
+
+        return;
+    }
+
+    int value = pending.load(std::memory_order_acquire);
+    while ((value & ~WAITER_FLAG) != 0)
+    {
+        // mark the group as waited for, so the last task wakes this thread
+        if (!(value & WAITER_FLAG))
+        {
+            if (!pending.compare_exchange_weak(value, value | WAITER_FLAG, std::memory_order_acquire,
+                    std::memory_order_acquire))
+                continue;
+            value |= WAITER_FLAG;
+        }
+
+        futex_wait(pending, value);
+        value = pending.load(std::memory_order_acquire);
+    }
+
+    // all tasks completed, the flag is not needed anymore
+    pending.store(0, std::memory_order_relaxed);
+}
+
+void TaskGroup::wait( )
+{
+    wait_pending();
+
+    if (failed.load(std::memory_order_acquire))
+    {
+        std::exception_ptr task_exception = exception;
+        exception = nullptr;
+        failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(task_exception);
+    }
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
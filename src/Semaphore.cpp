@@ -24,6 +24,7 @@
 // -------------------- standard library includes ----------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 #include <cerrno>
+#include <climits>
 #include <stdexcept>
 #include <sysexits.h>
 #include <iostream>
@@ -43,21 +44,22 @@ std::ostream* Semaphore::error_stream = &std::cerr;
 // ---------------------------------------------------------------------------------------------------------------------
 
 Semaphore::Semaphore(unsigned int value) :
-        max_value(value),
-        thread_queue(0)
+        value(static_cast<int>(value)),
+        locking_threads_mutex(PTHREAD_MUTEX_INITIALIZER),
+        max_value(value)
 {
     if(!value) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
             ": initializing a semaphore with maximum value of 0 is pointless.");
 
-    sysexcept(sem_init(&sem, 0, value), "sem_init", errno);
+    if(value > INT_MAX) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": maximum value must not be larger than INT_MAX.");
 }
 
 Semaphore::Semaphore(Semaphore &&other) noexcept :
-        sem(std::move(other.sem)),
+        value(std::move(other.value)),
         locking_threads(std::move(other.locking_threads)),
-        max_value(std::move(other.max_value)),
-        current_value(std::move(other.current_value)),
-        thread_queue(std::move(other.thread_queue))
+        locking_threads_mutex(std::move(other.locking_threads_mutex)),
+        max_value(std::move(other.max_value))
 { }
 
 
@@ -68,7 +70,8 @@ Semaphore::~Semaphore( )
 {
     try
     {
-        sysexcept(sem_destroy(&sem), "sem_destroy", errno);
+        int temp = pthread_mutex_destroy(&locking_threads_mutex);
+        sysexcept(temp != 0, "pthread_mutex_destroy", temp);
     }
     catch (const std::system_error& e)
     {
@@ -84,103 +87,127 @@ Semaphore& Semaphore::operator=(Semaphore &&other) noexcept
 {
     if (&other != this) // check for self assignment
     {
-        this->sem = std::move(other.sem);
+        this->value = std::move(other.value);
         this->locking_threads = std::move(other.locking_threads);
+        this->locking_threads_mutex = std::move(other.locking_threads_mutex);
         this->max_value = std::move(other.max_value);
-        this->current_value = std::move(other.current_value);
-        this->thread_queue = std::move(other.thread_queue);
     }
     
     return *this;
 }
 
-void Semaphore::wait( )
+void Semaphore::wait(unsigned int n)
 {
-    auto thread = pthread_self();
-
-    if(locking_threads[thread])
-        throw std::logic_error(std::string(__PRETTY_FUNCTION__) + 
-                ": Double wait within one thread is not allowed.");
-
-    thread_queue++;
+    verify_access_count(n);
 
-    sysexcept(sem_wait(&sem), "sem_wait", errno);
+    value.acquire(n, nullptr);
 
-    current_value++;
-    thread_queue--;
-    locking_threads[thread] = true;
+    add_locking_thread(n);
 }
 
-bool Semaphore::trywait( )
+bool Semaphore::wait(const StopToken &token, unsigned int n)
 {
-    auto thread = pthread_self();
+    verify_access_count(n);
 
-    if(locking_threads[thread])
-        throw std::logic_error(std::string(__PRETTY_FUNCTION__) + 
-                ": Double wait within one thread is not allowed.");
+    // the thread is queued like any other waiter, a stop request only wakes this thread
+    if (!value.acquire(n, nullptr, token)) return false;
 
-    thread_queue++;
+    add_locking_thread(n);
 
-    auto temp = sem_wait(&sem);
-    if(temp)
-    {
-        if(errno == EAGAIN)
-        {
-            thread_queue--;
-            return false;
-        }
-        sysexcept(true, "sem_wait", errno);
-    }
+    return true;
+}
+
+bool Semaphore::trywait(unsigned int n)
+{
+    verify_access_count(n);
 
-    current_value++;
-    thread_queue--;
-    locking_threads[thread] = true;
+    if (!value.try_acquire(n)) return false;
+
+    add_locking_thread(n);
 
     return true;
 }
 
 bool Semaphore::timedwait(const timespec &time)
 {
-    auto thread = pthread_self();
-
-    if(locking_threads[thread])
-        throw std::logic_error(std::string(__PRETTY_FUNCTION__) + 
-                ": Double wait within one thread is not allowed.");
+    return timedwait(1, time);
+}
 
-    auto timeout = pthread_timeout(time);
+bool Semaphore::timedwait(unsigned int n, const timespec &time)
+{
+    verify_access_count(n);
 
-    thread_queue++;
+    // the timeout is also verified if the semaphore is available
+    const timespec timeout_time = monotonic_timeout(time);
 
-    auto temp = sem_timedwait(&sem, &timeout);
-    if(temp)
-    {
-        if(errno == ETIMEDOUT)
-        {
-            thread_queue--;
-            return false;
-        }
-        sysexcept(true, "sem_wait", errno);
-    }
+    if (!value.acquire(n, &timeout_time)) return false;
 
-    current_value++;
-    thread_queue--;
-    locking_threads[thread] = true;
+    add_locking_thread(n);
 
     return true;
 }
 
-void Semaphore::post( )
+void Semaphore::post(unsigned int n)
 {
+    if (!n) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + ": releasing 0 accesses is pointless.");
+
     auto thread = pthread_self();
 
-    if(!locking_threads[thread])
+    int temp = pthread_mutex_lock(&locking_threads_mutex);
+    sysexcept(temp != 0, "pthread_mutex_lock", temp);
+
+    auto &held = locking_threads[thread];
+    bool holds_semaphore = held >= n;
+    if (holds_semaphore) held -= n;
+
+    temp = pthread_mutex_unlock(&locking_threads_mutex);
+    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+
+    if (!holds_semaphore)
         throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
                 ": Releasing a semaphore which the thread does not hold is not allowed.");
 
-    sysexcept(sem_post(&sem), "sem_post", errno);
+    // the thread holds the accesses: the maximum value can not be exceeded
+    value.release(n, max_value);
+}
+
+unsigned int Semaphore::get_current_value( ) const noexcept
+{
+    return get_snapshot().current_value;
+}
+
+Semaphore::snapshot_t Semaphore::get_snapshot( ) const noexcept
+{
+    const auto available = value.get_value();
+
+    snapshot_t snapshot;
+    snapshot.max_value = max_value;
+    snapshot.available = available > max_value ? max_value : available;
+    snapshot.current_value = max_value - snapshot.available;
+    snapshot.thread_queue = get_thread_queue();
+
+    return snapshot;
+}
+
+void Semaphore::verify_access_count(unsigned int n) const
+{
+    if (!n) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + ": acquiring 0 accesses is pointless.");
+
+    if (n > max_value) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": more accesses requested than the semaphore provides.");
+}
+
+void Semaphore::add_locking_thread(unsigned int n)
+{
+    auto thread = pthread_self();
+
+    int temp = pthread_mutex_lock(&locking_threads_mutex);
+    sysexcept(temp != 0, "pthread_mutex_lock", temp);
+
+    locking_threads[thread] += n;
 
-    current_value--;
-    locking_threads[thread] = false;
+    temp = pthread_mutex_unlock(&locking_threads_mutex);
+    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
 }
 
 } /* namespace Threading */
@@ -0,0 +1,251 @@
+/*
+ * \file SemaphoreCounter.cpp
+ * \brief Source file de::Koesling::Threading::semaphore_internal::counter
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "SemaphoreCounter.hpp"
+
+#include "futex.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <system_error>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+namespace semaphore_internal {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+counter::counter(int value) noexcept :
+        value(value),
+        reserved(0),
+        queued(0),
+        lock_word(0),
+        head(nullptr),
+        tail(nullptr)
+{ }
+
+counter::counter(counter &&other) noexcept :
+        value(other.value.load(std::memory_order_relaxed)),
+        reserved(0),
+        queued(0),
+        lock_word(0),
+        head(nullptr),
+        tail(nullptr)
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+counter& counter::operator=(counter &&other) noexcept
+{
+    if (&other != this) // check for self assignment
+        value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return *this;
+}
+
+bool counter::acquire(unsigned int n, const timespec *deadline, const StopToken &token)
+{
+    // spin briefly, the semaphore is usually held only for a short time
+    for (unsigned int i = 0; i < SPIN_COUNT; ++i)
+    {
+        if (try_acquire(n)) return true;
+        cpu_relax();
+    }
+
+    if (token.stop_requested()) return false;
+
+    return suspend(static_cast<int>(n), deadline, token);
+}
+
+bool counter::release(unsigned int n, unsigned int limit)
+{
+    const int count = static_cast<int>(n);
+    int available = value.load(std::memory_order_relaxed);
+    do
+    {
+        if (n > limit || available > static_cast<int>(limit - n)) return false;
+    }
+    while (!value.compare_exchange_weak(available, available + count, std::memory_order_seq_cst,
+            std::memory_order_relaxed));
+
+    // pairs with the increment in suspend(): either the queued thread sees the accesses or they are granted here
+    if (queued.load(std::memory_order_seq_cst) > 0)
+    {
+        futex_lock(lock_word);
+        try
+        {
+            grant();
+        }
+        catch (...)
+        {
+            futex_unlock(lock_word);
+            throw;
+        }
+        futex_unlock(lock_word);
+    }
+
+    return true;
+}
+
+bool counter::suspend(int count, const timespec *deadline, const StopToken &token)
+{
+    waiter_t waiter;
+    waiter.state.store(QUEUED, std::memory_order_relaxed);
+    waiter.count = count;
+    waiter.next = nullptr;
+
+    futex_lock(lock_word);
+
+    // announce the thread before the value is checked again by grant(), so release() can not miss it
+    queued.fetch_add(1, std::memory_order_seq_cst);
+    waiter.prev = tail;
+    if (tail) tail->next = &waiter;
+    else head = &waiter;
+    tail = &waiter;
+    reserved.store(head->count, std::memory_order_seq_cst);
+
+    try
+    {
+        grant();
+    }
+    catch (...)
+    {
+        futex_unlock(lock_word);
+        leave(waiter, true);
+        throw;
+    }
+    futex_unlock(lock_word);
+
+    // executed immediately if a stop was requested before, destroyed before the waiter object
+    auto wake = [this, &waiter]( ) { stop(waiter); };
+    StopCallback<decltype(wake)> stop_callback(token, wake);
+
+    try
+    {
+        while (waiter.state.load(std::memory_order_acquire) == QUEUED)
+        {
+            // timeout: leave() checks whether the accesses were granted in the meantime
+            if (!futex_wait(waiter.state, QUEUED, deadline)) break;
+        }
+    }
+    catch (...)
+    {
+        leave(waiter, true);
+        throw;
+    }
+
+    return leave(waiter, false);
+}
+
+void counter::stop(waiter_t &waiter) noexcept
+{
+    futex_lock(lock_word);
+
+    // the thread might already have got its accesses or left the queue
+    if (waiter.state.load(std::memory_order_relaxed) == QUEUED)
+    {
+        unlink(waiter);
+        waiter.state.store(STOPPED, std::memory_order_release);
+
+        try
+        {
+            futex_wake(waiter.state, 1);
+
+            // the accesses reserved for the stopped thread might be sufficient for the next queued threads
+            grant();
+        }
+        catch (const std::system_error &)
+        {
+            // not expected for valid futex words: the stopped thread re-checks its state when it wakes up
+        }
+    }
+
+    futex_unlock(lock_word);
+}
+
+bool counter::leave(waiter_t &waiter, bool give_back)
+{
+    // the thread that granted the accesses holds the lock while it wakes this thread: the waiter object must not be
+    // destroyed before
+    futex_lock(lock_word);
+
+    const int state = waiter.state.load(std::memory_order_relaxed);
+    const bool granted = state == GRANTED;
+    if (state == QUEUED) unlink(waiter);
+    else if (give_back) value.fetch_add(waiter.count, std::memory_order_seq_cst);
+
+    // the first queued thread might have left: the accesses it reserved can be granted to the next threads
+    try
+    {
+        grant();
+    }
+    catch (...)
+    {
+        futex_unlock(lock_word);
+        throw;
+    }
+    futex_unlock(lock_word);
+
+    return granted && !give_back;
+}
+
+void counter::grant( )
+{
+    while (head)
+    {
+        int available = value.load(std::memory_order_seq_cst);
+        bool taken = false;
+        while (available >= head->count)
+        {
+            if (value.compare_exchange_weak(available, available - head->count, std::memory_order_acquire,
+                    std::memory_order_relaxed))
+            {
+                taken = true;
+                break;
+            }
+        }
+        if (!taken) break;
+
+        waiter_t *waiter = head;
+        unlink(*waiter);
+        waiter->state.store(GRANTED, std::memory_order_release);
+        futex_wake(waiter->state, 1);
+    }
+}
+
+void counter::unlink(waiter_t &waiter) noexcept
+{
+    if (waiter.prev) waiter.prev->next = waiter.next;
+    else head = waiter.next;
+    if (waiter.next) waiter.next->prev = waiter.prev;
+    else tail = waiter.prev;
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+
+    // the accesses are reserved for the (new) first queued thread
+    reserved.store(head ? head->count : 0, std::memory_order_seq_cst);
+}
+
+} /* namespace semaphore_internal */
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,206 @@
+/*
+ * \file SharedCondition.cpp
+ * \brief Source file de::Koesling::Threading::SharedCondition
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "SharedCondition.hpp"
+
+#include "pthread_timeout.hpp"
+#include "sysexcept.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <sysexits.h>
+#include <iostream>
+
+
+// -------------------- Macros -----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+//! error message: double lock in one thread
+#define DOUBLE_LOCK std::string(__PRETTY_FUNCTION__) + ": The mutex must not be locked twice in the same thread."
+
+//! error message: mutex not held by the calling thread
+#define NOT_OWNER std::string(__PRETTY_FUNCTION__) + ": The mutex must be locked by the calling thread."
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* SharedCondition::error_stream = &std::cerr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+SharedCondition::SharedCondition( ) :
+        recovered(false)
+{
+    // mutex: process-shared, error checking, robust (a process may terminate while it holds the mutex)
+    pthread_mutexattr_t mutex_attr;
+    int temp = pthread_mutexattr_init(&mutex_attr);
+    sysexcept(temp != 0, "pthread_mutexattr_init", temp);
+
+    temp = pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+    if (temp == 0) temp = pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_ERRORCHECK);
+    if (temp == 0) temp = pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+    if (temp == 0) temp = pthread_mutex_init(&mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+    sysexcept(temp != 0, "pthread_mutex_init", temp);
+
+    // condition: process-shared, timeouts refer to CLOCK_MONOTONIC
+    pthread_condattr_t cond_attr;
+    temp = pthread_condattr_init(&cond_attr);
+    if (temp != 0)
+    {
+        pthread_mutex_destroy(&mutex);
+        sysexcept(true, "pthread_condattr_init", temp);
+    }
+
+    temp = pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+    if (temp == 0) temp = pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    if (temp == 0) temp = pthread_cond_init(&condition, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    if (temp != 0)
+    {
+        pthread_mutex_destroy(&mutex);
+        sysexcept(true, "pthread_cond_init", temp);
+    }
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+SharedCondition::~SharedCondition( )
+{
+    try
+    {
+        int temp = pthread_cond_destroy(&condition);
+        sysexcept(temp != 0, "pthread_cond_destroy", temp);
+
+        temp = pthread_mutex_destroy(&mutex);
+        sysexcept(temp != 0, "pthread_mutex_destroy", temp);
+    }
+    catch (const std::system_error &e)
+    {
+        // failed to destroy mutex/condition --> major error --> terminate
+        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SharedCondition::lock( )
+{
+    int temp = recover(pthread_mutex_lock(&mutex));
+    if (temp == EDEADLK) throw std::logic_error(DOUBLE_LOCK);
+    sysexcept(temp != 0, "pthread_mutex_lock", temp);
+}
+
+bool SharedCondition::trylock( )
+{
+    int temp = recover(pthread_mutex_trylock(&mutex));
+    if (temp == EBUSY) return false;
+    sysexcept(temp != 0, "pthread_mutex_trylock", temp);
+
+    return true;
+}
+
+bool SharedCondition::owner_died( ) noexcept
+{
+    const bool result = recovered;
+    recovered = false;
+    return result;
+}
+
+void SharedCondition::unlock( )
+{
+    int temp = pthread_mutex_unlock(&mutex);
+    if (temp == EPERM) throw std::logic_error(NOT_OWNER);
+    sysexcept(temp != 0, "pthread_mutex_unlock", temp);
+}
+
+void SharedCondition::wait( )
+{
+    wait_once(nullptr);
+}
+
+bool SharedCondition::timedwait(const timespec &time)
+{
+    const timespec timeout_time = timeout(time);
+    return wait_once(&timeout_time);
+}
+
+bool SharedCondition::wait_once(const timespec *timeout_time)
+{
+    // the mutex is locked again, even if its last owner terminated: the caller rechecks the shared state anyway
+    int temp = recover(timeout_time ? pthread_cond_timedwait(&condition, &mutex, timeout_time) :
+            pthread_cond_wait(&condition, &mutex));
+
+    if (temp == ETIMEDOUT) return false;
+    if (temp == EPERM) throw std::logic_error(NOT_OWNER);
+    sysexcept(temp != 0, timeout_time ? "pthread_cond_timedwait" : "pthread_cond_wait", temp);
+
+    return true;
+}
+
+int SharedCondition::recover(int result)
+{
+    if (result != EOWNERDEAD) return result;
+
+    // the calling thread holds the mutex, without pthread_mutex_consistent it becomes unusable once it is unlocked
+    int temp = pthread_mutex_consistent(&mutex);
+    if (temp != 0)
+    {
+        pthread_mutex_unlock(&mutex);
+        sysexcept(true, "pthread_mutex_consistent", temp);
+    }
+
+    recovered = true;
+    return 0;
+}
+
+timespec SharedCondition::timeout(const timespec &time)
+{
+    return monotonic_timeout(time);
+}
+
+void SharedCondition::signal( )
+{
+    int temp = pthread_cond_signal(&condition);
+    sysexcept(temp != 0, "pthread_cond_signal", temp);
+}
+
+void SharedCondition::broadcast( )
+{
+    int temp = pthread_cond_broadcast(&condition);
+    sysexcept(temp != 0, "pthread_cond_broadcast", temp);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,116 @@
+/*
+ * \file SharedSemaphore.cpp
+ * \brief Source file de::Koesling::Threading::SharedSemaphore
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "SharedSemaphore.hpp"
+
+#include "pthread_timeout.hpp"
+#include "sysexcept.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cerrno>
+#include <stdexcept>
+#include <sysexits.h>
+#include <iostream>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* SharedSemaphore::error_stream = &std::cerr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+SharedSemaphore::SharedSemaphore(unsigned int value) :
+        max_value(value)
+{
+    if(!value) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": initializing a semaphore with maximum value of 0 is pointless.");
+
+    // pshared != 0 --> semaphore is shared between processes
+    sysexcept(sem_init(&sem, 1, value), "sem_init", errno);
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+SharedSemaphore::~SharedSemaphore( )
+{
+    try
+    {
+        sysexcept(sem_destroy(&sem), "sem_destroy", errno);
+    }
+    catch (const std::system_error& e)
+    {
+        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SharedSemaphore::wait( )
+{
+    int temp;
+    do temp = sem_wait(&sem);
+    while (temp && errno == EINTR);
+
+    sysexcept(temp, "sem_wait", errno);
+}
+
+bool SharedSemaphore::trywait( )
+{
+    if (sem_trywait(&sem))
+    {
+        if (errno == EAGAIN) return false;
+        sysexcept(true, "sem_trywait", errno);
+    }
+
+    return true;
+}
+
+bool SharedSemaphore::timedwait(const timespec &time)
+{
+    return sem_wait_for(&sem, time);
+}
+
+void SharedSemaphore::post( )
+{
+    sysexcept(sem_post(&sem), "sem_post", errno);
+}
+
+unsigned int SharedSemaphore::get_value( )
+{
+    int value;
+    sysexcept(sem_getvalue(&sem, &value), "sem_getvalue", errno);
+
+    // linux never reports the number of waiting threads as negative value
+    return value < 0 ? 0 : static_cast<unsigned int>(value);
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
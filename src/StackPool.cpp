@@ -0,0 +1,201 @@
+/*
+ * \file StackPool.cpp
+ * \brief Source file de::Koesling::Threading::StackPool
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "StackPool.hpp"
+
+#include "sysexcept.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cerrno>
+#include <climits>
+#include <iostream>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sysexits.h>
+#include <unistd.h>
+
+
+// -------------------- error messages ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+//! error message: stack too small
+#define STACK_TOO_SMALL std::string(__PRETTY_FUNCTION__) + ": The stack size must be at least PTHREAD_STACK_MIN (" + \
+    std::to_string(PTHREAD_STACK_MIN) + " bytes)."
+
+//! error message: stacks not released
+#define STACKS_NOT_RELEASED std::string(__PRETTY_FUNCTION__) + ": " + std::to_string(acquired) + " stack(s) not " \
+    "released. The stacks stay mapped."
+
+//! error message: release more stacks than acquired
+#define RELEASE_NOT_ACQUIRED std::string(__PRETTY_FUNCTION__) + ": More stacks released than acquired."
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+//! round size up to a multiple of the page size
+static std::size_t page_round_up(std::size_t size)
+{
+    const long page_size_value = sysconf(_SC_PAGESIZE);
+    sysexcept(page_size_value < 0, "sysconf", errno);
+
+    const std::size_t page_size = static_cast<std::size_t>(page_size_value);
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* StackPool::error_stream = &std::cerr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+StackPool::StackPool(std::size_t stack_size, std::size_t max_cached, std::size_t guard_size) :
+        stack_size(page_round_up(stack_size)),
+        guard_size(page_round_up(guard_size)),
+        max_cached(max_cached),
+        acquired(0)
+{
+    if (stack_size < static_cast<std::size_t>(PTHREAD_STACK_MIN)) throw std::invalid_argument(STACK_TOO_SMALL);
+
+    cached.reserve(max_cached);
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+StackPool::~StackPool( )
+{
+    if (acquired)
+    {
+        // threads might still use the stacks
+        std::logic_error e(STACKS_NOT_RELEASED);
+        destructor_exception_continue(e, *error_stream);
+    }
+
+    try
+    {
+        for (auto stack : cached)
+            unmap(stack);
+    }
+    catch (const std::system_error &e)
+    {
+        destructor_exception_continue(e, *error_stream);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+void* StackPool::acquire( )
+{
+    mutex.lock();
+    if (!cached.empty())
+    {
+        void *stack = cached.back();
+        cached.pop_back();
+        acquired++;
+        mutex.unlock();
+        return stack;
+    }
+    acquired++;
+    mutex.unlock();
+
+    // map guard area and stack without access, then allow access to the stack (the guard area is below the stack,
+    // stacks grow downwards)
+    void *mapping = mmap(nullptr, guard_size + stack_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK |
+            MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        const int error = errno;
+        mutex.lock();
+        acquired--;
+        mutex.unlock();
+        sysexcept(true, "mmap", error);
+    }
+
+    void *stack = static_cast<char*>(mapping) + guard_size;
+    if (mprotect(stack, stack_size, PROT_READ | PROT_WRITE))
+    {
+        const int error = errno;
+        munmap(mapping, guard_size + stack_size);
+        mutex.lock();
+        acquired--;
+        mutex.unlock();
+        sysexcept(true, "mprotect", error);
+    }
+
+    return stack;
+}
+
+void StackPool::release(void *stack)
+{
+    mutex.lock();
+    if (!acquired)
+    {
+        mutex.unlock();
+        throw std::logic_error(RELEASE_NOT_ACQUIRED);
+    }
+    acquired--;
+
+    if (cached.size() < max_cached)
+    {
+        // capacity reserved by the constructor: push_back does not throw
+        cached.push_back(stack);
+        mutex.unlock();
+        return;
+    }
+    mutex.unlock();
+
+    unmap(stack);
+}
+
+void StackPool::unmap(void *stack)
+{
+    sysexcept(munmap(static_cast<char*>(stack) - guard_size, guard_size + stack_size), "munmap", errno);
+}
+
+std::size_t StackPool::get_cached_count( )
+{
+    mutex.lock();
+    const std::size_t count = cached.size();
+    mutex.unlock();
+    return count;
+}
+
+std::size_t StackPool::get_acquired_count( )
+{
+    mutex.lock();
+    const std::size_t count = acquired;
+    mutex.unlock();
+    return count;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,214 @@
+/*
+ * \file StopToken.cpp
+ * \brief Source file de::Koesling::Threading::StopSource, de::Koesling::Threading::StopToken and
+ *        de::Koesling::Threading::StopCallback
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "StopToken.hpp"
+
+#include "futex.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <climits>
+#include <system_error>
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+namespace stop_internal {
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+callback_base::callback_base(void (*invoke)(callback_base *callback)) noexcept :
+        prev(nullptr),
+        next(nullptr),
+        linked(false),
+        destroyed(nullptr),
+        done(0),
+        invoke(invoke)
+{ }
+
+stop_state::stop_state( ) noexcept :
+        stopped(false),
+        lock_word(0),
+        head(nullptr),
+        executing(nullptr),
+        requesting_thread( )
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool stop_state::request_stop( ) noexcept
+{
+    futex_lock(lock_word);
+    if (stopped.load(std::memory_order_relaxed))
+    {
+        futex_unlock(lock_word);
+        return false;
+    }
+
+    // set while the lock is held: add_callback either sees the stop or adds the callback before it is executed here
+    stopped.store(true, std::memory_order_release);
+    requesting_thread = pthread_self( );
+
+    while (head)
+    {
+        callback_base *callback = head;
+        head = callback->next;
+        if (head) head->prev = nullptr;
+        callback->linked = false;
+
+        bool destroyed = false;
+        callback->destroyed = &destroyed;
+        executing = callback;
+
+        // the callback may register or deregister callbacks: the lock must not be held
+        futex_unlock(lock_word);
+        callback->invoke(callback);
+
+        if (!destroyed)
+        {
+            callback->destroyed = nullptr;
+
+            // system call only if the owner of the callback waits in remove_callback
+            if (callback->done.exchange(2, std::memory_order_acq_rel) == 1)
+            {
+                try
+                {
+                    futex_wake(callback->done, INT_MAX);
+                }
+                catch (const std::system_error &)
+                {
+                    // the callback might already be destroyed (the owner was woken by a signal): nothing to wake up
+                }
+            }
+        }
+
+        futex_lock(lock_word);
+        executing = nullptr;
+    }
+
+    futex_unlock(lock_word);
+    return true;
+}
+
+bool stop_state::add_callback(callback_base &callback) noexcept
+{
+    futex_lock(lock_word);
+    if (stopped.load(std::memory_order_relaxed))
+    {
+        futex_unlock(lock_word);
+        return false;
+    }
+
+    callback.prev = nullptr;
+    callback.next = head;
+    if (head) head->prev = &callback;
+    head = &callback;
+    callback.linked = true;
+
+    futex_unlock(lock_word);
+    return true;
+}
+
+void stop_state::remove_callback(callback_base &callback) noexcept
+{
+    futex_lock(lock_word);
+
+    // not executed yet
+    if (callback.linked)
+    {
+        if (callback.prev) callback.prev->next = callback.next;
+        else head = callback.next;
+        if (callback.next) callback.next->prev = callback.prev;
+        callback.linked = false;
+
+        futex_unlock(lock_word);
+        return;
+    }
+
+    if (executing != &callback)
+    {
+        // already executed
+        futex_unlock(lock_word);
+        return;
+    }
+
+    // destroyed by its own execution: request_stop must not access the callback anymore
+    if (pthread_equal(requesting_thread, pthread_self( )))
+    {
+        *callback.destroyed = true;
+        futex_unlock(lock_word);
+        return;
+    }
+
+    futex_unlock(lock_word);
+
+    // executed by another thread: wait until the callback completed
+    int state = 0;
+    if (!callback.done.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_acquire) &&
+            state == 2)
+        return;
+
+    while (callback.done.load(std::memory_order_acquire) != 2)
+    {
+        try
+        {
+            futex_wait(callback.done, 1);
+        }
+        catch (const std::system_error &)
+        {
+            // not expected for a valid futex word: check the state again
+            cpu_relax( );
+        }
+    }
+}
+
+} /* namespace stop_internal */
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+StopToken::StopToken(std::shared_ptr<stop_internal::stop_state> state) noexcept :
+        state(std::move(state))
+{ }
+
+StopSource::StopSource( ) :
+        state(std::make_shared<stop_internal::stop_state>( ))
+{ }
+
+StopSource::StopSource(std::nullptr_t) noexcept :
+        state(nullptr)
+{ }
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool StopSource::request_stop( ) noexcept
+{
+    return state && state->request_stop( );
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -3,7 +3,7 @@
  * \brief Source file de::Koesling::Threading::Thread
  *
   * required compiler options:
- *          -std=c++11 (or higher)
+ *          -std=c++14 (or higher)
  *          -pthread
  *
  * recommended compiler options:
@@ -17,15 +17,30 @@
 // ---------------------------------------------------------------------------------------------------------------------
 #include "Thread.hpp"
 
+#include "StackPool.hpp"
+
+#include "futex.hpp"
 #include "sysexcept.hpp"
+#include "thread_registry.hpp"
 #include "destructor_exception.hpp"
 
 
 // -------------------- standard library includes ----------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 #include <system_error>
+#include <cstdint>
 #include <csignal>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
 #include <sys/time.h>
 #include <iostream>
 #include <sysexits.h>
@@ -55,23 +70,178 @@
 #define JOIN_NOT_STARTED std::string(__PRETTY_FUNCTION__) + ": Call of Thread::join(), nut thread is not started "\
     "or was killed"
 
+//! error message: start a callable thread twice
+#define CALLABLE_CONSUMED_MSG std::string(__PRETTY_FUNCTION__) + ": Call of Thread::start(), but the callable was "\
+    "already executed. A Thread that executes a callable can only be started once."
+
 //! error message: cancel a thread that was not started
 #define CANCEL_STOPPED std::string(__PRETTY_FUNCTION__) + ": Call of Thread::kill(), but thread is not running."
 
+//! error message: change the stack of a running thread
+#define STACK_RUNNING std::string(__PRETTY_FUNCTION__) + ": The stack can not be changed while the thread is running."
+
+//! error message: change the stack size of a user supplied stack
+#define STACK_SIZE_FIXED std::string(__PRETTY_FUNCTION__) + ": The stack size can not be changed after a stack was " \
+    "set with set_stack()."
+
+//! error message: empty cpu set
+#define EMPTY_CPU_SET std::string(__PRETTY_FUNCTION__) + ": The CPU set must not be empty."
+
+//! error message: thread name too long
+#define NAME_TOO_LONG std::string(__PRETTY_FUNCTION__) + ": The thread name '" + name + "' is too long (maximum: " + \
+    std::to_string(NAME_MAX_LENGTH) + " characters)."
+
+//! error message: cpu time of a thread that is not running
+#define CPU_TIME_STOPPED std::string(__PRETTY_FUNCTION__) + ": Call of Thread::get_cpu_time(), but thread is not " \
+    "running."
+
+//! error message: settings of a detached thread
+#define DETACHED_ACCESS std::string(__PRETTY_FUNCTION__) + ": The thread is detached. It might have terminated, " \
+    "its settings can not be accessed."
+
 //! error message: signal rise, but thread is not running
 #define SIGNAL_STOPPED std::string(__PRETTY_FUNCTION__) + ": Call of Thread::signal(), but thread is not running."
 
 
+//! error message: invalid scheduling policy
+#define INVALID_POLICY std::string(__PRETTY_FUNCTION__) + ": scheduling policy is invalid."
+
+//! error message: deadline policy via set_scheduling
+#define USE_SET_DEADLINE std::string(__PRETTY_FUNCTION__) + ": Use Thread::set_deadline() for SCHED_DEADLINE."
+
+//! error message: invalid priority
+#define INVALID_PRIORITY std::string(__PRETTY_FUNCTION__) + ": priority " + std::to_string(priority) + \
+    " is out of range for this policy (" + std::to_string(min) + " - " + std::to_string(max) + ")."
+
+//! error message: invalid nice value
+#define INVALID_NICE std::string(__PRETTY_FUNCTION__) + ": nice value " + std::to_string(nice) + \
+    " is out of range (-20 - 19)."
+
+//! error message: invalid deadline parameters
+#define INVALID_DEADLINE std::string(__PRETTY_FUNCTION__) + ": SCHED_DEADLINE requires 0 < runtime <= deadline <= " \
+    "period."
+
+//! explanation for missing privileges
+#define SCHED_PERMISSION " (insufficient privileges: real-time policies, SCHED_DEADLINE, higher priorities and lower " \
+    "nice values require CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO / RLIMIT_NICE)"
+
+/*! like sysexcept, but explains missing privileges (EPERM, EACCES)
+ *
+ * arguments: see sysexcept
+ */
+#define schedexcept(condition, function_name, error_number) do                                                         \
+{                                                                                                                      \
+    if (condition)                                                                                                     \
+        throw std::system_error(std::error_code((error_number), std::system_category( )),                              \
+                std::string(__PRETTY_FUNCTION__) + " - " + (function_name) +                                           \
+                ((error_number) == EPERM || (error_number) == EACCES ? SCHED_PERMISSION : ""));                        \
+}                                                                                                                      \
+while (false)
+
+
 // -------------------- General constants and definitions --------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 #define NSEC_PER_SEC 1000000000
 #define NSEC_PER_USEC 1000
 
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
 
 namespace de {
 namespace Koesling {
 namespace Threading {
 
+//! parameters of the sched_setattr system call (no glibc wrapper, see man sched_setattr)
+struct sched_attr_t
+{
+    std::uint32_t size;
+    std::uint32_t sched_policy;
+    std::uint64_t sched_flags;
+    std::int32_t sched_nice;
+    std::uint32_t sched_priority;
+    std::uint64_t sched_runtime;
+    std::uint64_t sched_deadline;
+    std::uint64_t sched_period;
+};
+
+/*! switch a thread to SCHED_DEADLINE
+ *
+ * return value: 0 on success, -1 on error (errno is set)
+ */
+static int set_sched_deadline(pid_t tid, std::uint64_t runtime, std::uint64_t deadline, std::uint64_t period) noexcept
+{
+    sched_attr_t attr = { };
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_runtime = runtime;
+    attr.sched_deadline = deadline;
+    attr.sched_period = period;
+
+    return static_cast<int>(syscall(SYS_sched_setattr, tid, &attr, 0));
+}
+
+//! convert a timespec to ns
+static std::uint64_t to_ns(const struct timespec &time)
+{
+    if (time.tv_sec < 0 || time.tv_nsec < 0 || time.tv_nsec >= NSEC_PER_SEC) throw std::invalid_argument(
+            "invalid timespec");
+
+    return static_cast<std::uint64_t>(time.tv_sec) * NSEC_PER_SEC + static_cast<std::uint64_t>(time.tv_nsec);
+}
+
+//! registration of a thread started by a Thread object, removed from the registry when the thread terminates
+struct thread_registration_t
+{
+    //! registry entry
+    thread_registry_entry_t entry;
+
+    //! true: entry is in the registry
+    bool registered = false;
+
+    //! stop token of the Thread object that started the thread (see Thread::get_my_stop_token)
+    StopToken stop_token;
+
+    ~thread_registration_t( )
+    {
+        if (!registered) return;
+
+        try
+        {
+            thread_registry_remove(entry);
+        }
+        catch (const std::system_error &e)
+        {
+            destructor_exception_terminate(e, std::cerr, EX_OSERR);
+        }
+    }
+};
+
+//! registration of the calling thread (not registered until thread_startup)
+static thread_local thread_registration_t registration;
+
+/*! read name and state of a thread of this process from /proc/self/task/<tid>/stat
+ *
+ * return value: false if the file can not be read (the thread terminated)
+ */
+static bool read_task_stat(pid_t tid, std::string &name, char &state)
+{
+    std::ifstream file("/proc/self/task/" + std::to_string(tid) + "/stat");
+    std::string stat;
+    if (!file || !std::getline(file, stat)) return false;
+
+    // format: "tid (name) state ...", the name might contain parentheses
+    const auto name_begin = stat.find('(');
+    const auto name_end = stat.rfind(')');
+    if (name_begin == std::string::npos || name_end == std::string::npos || name_end < name_begin ||
+            name_end + 2 >= stat.size()) return false;
+
+    name = stat.substr(name_begin + 1, name_end - name_begin - 1);
+    state = stat[name_end + 2];
+    return true;
+}
+
 // -------------------- Initialize static attributes -------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 std::ostream* Thread::error_stream = &std::cerr;
@@ -81,7 +251,9 @@ std::ostream* Thread::error_stream = &std::cerr;
 // ---------------------------------------------------------------------------------------------------------------------
 
 Thread::Thread(thread_function_t function) :
-        thread_id(0), funcion(function), running(false), detachstate(JOINABLE), arguments(nullptr)
+        thread_id(0), funcion(function), running(false), detachstate(JOINABLE), arguments(nullptr),
+        stack(nullptr), stack_pool(nullptr), stack_in_use(false), callable_ops(nullptr),
+        callable_state(CALLABLE_CONSUMED), startup(), startup_error(0), tid(0), name(), stop_source()
 {
     // create pthread_attr object ( + error handling )
     int temp = pthread_attr_init(&attributes);
@@ -89,7 +261,9 @@ Thread::Thread(thread_function_t function) :
 }
 
 Thread::Thread(thread_function_t function, detachstate_t detachstate) :
-        thread_id(0), funcion(function), running(false), detachstate(detachstate), arguments(nullptr)
+        thread_id(0), funcion(function), running(false), detachstate(detachstate), arguments(nullptr),
+        stack(nullptr), stack_pool(nullptr), stack_in_use(false), callable_ops(nullptr),
+        callable_state(CALLABLE_CONSUMED), startup(), startup_error(0), tid(0), name(), stop_source()
 {
     // create pthread_attr object ( + error handling )
     int temp = pthread_attr_init(&attributes);
@@ -102,7 +276,9 @@ Thread::Thread(thread_function_t function, detachstate_t detachstate) :
 }
 
 Thread::Thread(thread_function_t function, const pthread_attr_t &attributes) :
-        thread_id(0), funcion(function), running(false), attributes(attributes), arguments(nullptr)
+        thread_id(0), funcion(function), running(false), attributes(attributes), arguments(nullptr),
+        stack(nullptr), stack_pool(nullptr), stack_in_use(false), callable_ops(nullptr),
+        callable_state(CALLABLE_CONSUMED), startup(), startup_error(0), tid(0), name(), stop_source()
 {
     // get detachstate from attributes object ( + error handling )
     int temp_detachstate;
@@ -113,14 +289,59 @@ Thread::Thread(thread_function_t function, const pthread_attr_t &attributes) :
     detachstate = temp_detachstate == PTHREAD_CREATE_JOINABLE ? JOINABLE : DETACHED;
 }
 
+Thread::Thread(std::nullptr_t) :
+        thread_id(0), funcion(nullptr), running(false), detachstate(JOINABLE), arguments(nullptr),
+        stack(nullptr), stack_pool(nullptr), stack_in_use(false), callable_ops(nullptr),
+        callable_state(CALLABLE_CONSUMED), startup(), startup_error(0), tid(0), name(), stop_source()
+{
+    // create pthread_attr object ( + error handling )
+    int temp = pthread_attr_init(&attributes);
+    sysexcept(temp != 0, "pthread_attr_init", temp);
+}
+
 Thread::Thread(Thread &&other) noexcept :
         thread_id(std::move(other.thread_id)),
         funcion(std::move(other.funcion)),
         running(std::move(other.running)),
         detachstate(std::move(other.detachstate)),
         attributes(std::move(other.attributes)),
-        arguments(std::move(other.arguments))
-{ }
+        arguments(std::move(other.arguments)),
+        stack(other.stack),
+        stack_pool(other.stack_pool),
+        stack_in_use(other.stack_in_use),
+        callable_ops(other.callable_ops),
+        callable_state(CALLABLE_CONSUMED),
+        startup(other.startup),
+        startup_error(0),
+        tid(0),
+        name(),
+        stop_source(nullptr)
+{
+    // the started thread might still access the callable buffer and the stop source of the other object
+    other.wait_callable_taken( );
+    tid = other.tid;
+    std::memcpy(name, other.name, sizeof(name));
+    stop_source = std::move(other.stop_source);
+
+    if (callable_ops && other.callable_state.load(std::memory_order_relaxed) == CALLABLE_STORED)
+    {
+        callable_ops->relocate(&other.callable_buffer, &callable_buffer);
+        callable_state.store(CALLABLE_STORED, std::memory_order_relaxed);
+    }
+
+    // the other object must neither cancel the thread nor destroy the callable nor release the stack
+    other.running = false;
+    other.stack = nullptr;
+    other.stack_pool = nullptr;
+    other.stack_in_use = false;
+    other.tid = 0;
+    other.callable_ops = nullptr;
+    other.callable_state.store(CALLABLE_CONSUMED, std::memory_order_relaxed);
+
+    // the attributes might reference allocated memory (e.g. the cpu set) that is released by pthread_attr_destroy:
+    // the other object gets new attributes (pthread_attr_init can not fail on linux)
+    pthread_attr_init(&other.attributes);
+}
 
 
 // -------------------- Destructor -------------------------------------------------------------------------------------
@@ -128,16 +349,24 @@ Thread::Thread(Thread &&other) noexcept :
 
 Thread::~Thread( )
 {
-    // kill thread if it is running and joinable, because joining is no longer
-    //     possible.
+    // the started thread must take the callable before it can be cancelled
+    wait_callable_taken( );
+    if (callable_ops && callable_state.load(std::memory_order_relaxed) == CALLABLE_STORED)
+        callable_ops->destroy(&callable_buffer);
+
+    // stop and join the thread if it is running and joinable, because joining
+    //     is no longer possible afterwards. The thread is not cancelled: it
+    //     might hold locks or leave data in an inconsistent state.
     // running == true --> std::logic error can not be thrown.
     // handling of system_error is barely possible. However, this could only
     // occur in the event of major system errors.
     if (running && detachstate == JOINABLE)
     {
-        try	// to cancel
+        request_stop( );
+
+        try	// to join
         {
-            cancel( );
+            join( );
         }
         catch (const std::system_error &e)
         {
@@ -145,6 +374,8 @@ Thread::~Thread( )
         }
     }
 
+    release_stack( );
+
     try // to destroy the pthread_attr object
     {
         int temp = pthread_attr_destroy(&attributes);
@@ -168,12 +399,49 @@ Thread& Thread::operator =(Thread &&other) noexcept
 {
     if (this != &other) // check for self assignment
     {
+        // destroy the own callable
+        wait_callable_taken( );
+        if (callable_ops && callable_state.load(std::memory_order_relaxed) == CALLABLE_STORED)
+            callable_ops->destroy(&callable_buffer);
+
         this->thread_id = std::move(other.thread_id);
         this->funcion = std::move(other.funcion);
         this->running = std::move(other.running);
         this->detachstate = std::move(other.detachstate);
+        release_stack( );
+        this->stack = other.stack;
+        this->stack_pool = other.stack_pool;
+        this->stack_in_use = other.stack_in_use;
+        pthread_attr_destroy(&attributes);
         this->attributes = std::move(other.attributes);
         this->arguments = std::move(other.arguments);
+        this->callable_ops = other.callable_ops;
+        this->callable_state.store(CALLABLE_CONSUMED, std::memory_order_relaxed);
+
+        // the started thread might still access the callable buffer and the stop source of the other object
+        other.wait_callable_taken( );
+        this->tid = other.tid;
+        this->startup = other.startup;
+        std::memcpy(this->name, other.name, sizeof(this->name));
+        this->stop_source = std::move(other.stop_source);
+
+        if (callable_ops && other.callable_state.load(std::memory_order_relaxed) == CALLABLE_STORED)
+        {
+            callable_ops->relocate(&other.callable_buffer, &callable_buffer);
+            callable_state.store(CALLABLE_STORED, std::memory_order_relaxed);
+        }
+
+        // the other object must neither cancel the thread nor destroy the callable nor release the stack
+        other.running = false;
+        other.stack = nullptr;
+        other.stack_pool = nullptr;
+        other.stack_in_use = false;
+        other.tid = 0;
+        other.callable_ops = nullptr;
+        other.callable_state.store(CALLABLE_CONSUMED, std::memory_order_relaxed);
+
+        // see move constructor
+        pthread_attr_init(&other.attributes);
     }
 
     return *this;
@@ -185,11 +453,146 @@ void Thread::start( )
     // thread id would be lost --> join impossible
     if (running) throw std::logic_error( ALREADY_STARTED);
 
-    // create a new thread ( + error handling )
-    int temp = pthread_create(&thread_id, &attributes, funcion, arguments);
-    sysexcept(temp != 0, "pthread_create", temp);
+    // a stop requested for the previous run must not stop the new one (tid is set by every started thread)
+    if (tid != 0 && stop_source.stop_requested( )) stop_source = StopSource( );
+
+    int temp;
+    startup_error = 0;
+    if (callable_ops)
+    {
+        // the callable is moved out of this object by the started thread
+        if (callable_state.load(std::memory_order_relaxed) != CALLABLE_STORED)
+            throw std::logic_error(CALLABLE_CONSUMED_MSG);
+
+        callable_state.store(CALLABLE_STARTED, std::memory_order_relaxed);
+
+        // create a new thread ( + error handling )
+        temp = pthread_create(&thread_id, &attributes, callable_ops->run, this);
+        if (temp != 0) callable_state.store(CALLABLE_STORED, std::memory_order_relaxed);
+    }
+    else
+    {
+        // the thread function and the arguments are read by the started thread
+        callable_state.store(CALLABLE_STARTED, std::memory_order_relaxed);
+
+        // create a new thread ( + error handling )
+        temp = pthread_create(&thread_id, &attributes, function_trampoline, this);
+        if (temp != 0) callable_state.store(CALLABLE_CONSUMED, std::memory_order_relaxed);
+    }
+    // EPERM: scheduling policy set with set_scheduling, but not permitted
+    schedexcept(temp != 0, "pthread_create", temp);
 
     running = true;
+    stack_in_use = true;
+
+    // the settings that are applied by the started thread might fail
+    if (startup.set_nice || startup.set_deadline)
+    {
+        wait_callable_taken( );
+        if (startup_error)
+        {
+            // the thread returns without executing the function
+            if (detachstate == JOINABLE) pthread_join(thread_id, nullptr);
+            running = false;
+            stack_in_use = detachstate == DETACHED;
+            schedexcept(true, startup.set_deadline ? "sched_setattr" : "setpriority", startup_error);
+        }
+    }
+}
+
+bool Thread::thread_startup(Thread *self) noexcept
+{
+    self->tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+    registration.stop_token = self->stop_source.get_token( );
+
+    registration.entry.tid = self->tid;
+    try
+    {
+        thread_registry_add(registration.entry);
+        registration.registered = true;
+    }
+    catch (const std::system_error &)
+    {
+        // not expected (the clock of the calling thread is always available): the thread is not listed by
+        // get_threads()
+    }
+
+    // EINVAL/ERANGE not possible: the length is checked by set_name
+    if (self->name[0]) pthread_setname_np(pthread_self( ), self->name);
+
+    int error = 0;
+    if (self->startup.set_deadline)
+    {
+        if (set_sched_deadline(self->tid, self->startup.runtime, self->startup.deadline, self->startup.period))
+            error = errno;
+    }
+    else if (self->startup.set_nice)
+    {
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(self->tid), self->startup.nice)) error = errno;
+    }
+
+    if (error)
+    {
+        self->startup_error = error;
+        callable_taken(self->callable_state, CALLABLE_STORED);
+        return false;
+    }
+
+    return true;
+}
+
+void* Thread::function_trampoline(void *thread)
+{
+    Thread *self = static_cast<Thread*>(thread);
+    if (!thread_startup(self)) return nullptr;
+
+    thread_function_t function = self->funcion;
+    void *arguments = self->arguments;
+    callable_taken(self->callable_state);
+
+    return function(arguments);
+}
+
+void Thread::callable_taken(std::atomic<int> &state, int new_state) noexcept
+{
+    // system call only if the owner of the Thread object waits
+    if (state.exchange(new_state, std::memory_order_acq_rel) == CALLABLE_WAITING)
+    {
+        try
+        {
+            futex_wake(state, INT_MAX);
+        }
+        catch (const std::system_error &)
+        {
+            // the Thread object might already be destroyed (the waiting thread was woken by a signal):
+            // nothing to wake up
+        }
+    }
+}
+
+void Thread::wait_callable_taken( ) noexcept
+{
+    int state = callable_state.load(std::memory_order_acquire);
+    while (state == CALLABLE_STARTED || state == CALLABLE_WAITING)
+    {
+        // announce the waiting thread, so callable_taken() wakes it
+        if (state == CALLABLE_STARTED && !callable_state.compare_exchange_weak(state, CALLABLE_WAITING,
+                std::memory_order_acquire, std::memory_order_acquire))
+            continue;
+
+        try
+        {
+            futex_wait(callable_state, CALLABLE_WAITING);
+        }
+        catch (const std::system_error &)
+        {
+            // not expected for a valid futex word: check the state again
+            cpu_relax( );
+        }
+
+        state = callable_state.load(std::memory_order_acquire);
+    }
 }
 
 void Thread::detach( )
@@ -223,6 +626,7 @@ void Thread::join(void **return_value)
     sysexcept(temp != 0, "pthread_join", temp);
 
     running = false;
+    stack_in_use = false;
 }
 
 bool Thread::try_join(void **return_value)
@@ -242,6 +646,7 @@ bool Thread::try_join(void **return_value)
     }
 
     running = false;
+    stack_in_use = false;
     return true;
 }
 
@@ -282,6 +687,7 @@ bool Thread::timed_join(const struct timespec &time, void **return_value)
     }
 
     running = false;
+    stack_in_use = false;
     return true;
 }
 
@@ -307,6 +713,405 @@ void Thread::send_signal(int signum)
     sysexcept(temp != 0, "pthread_kill", temp);
 }
 
+void Thread::set_affinity(const CpuSet &cpus)
+{
+    if (cpus.empty()) throw std::invalid_argument(EMPTY_CPU_SET);
+
+    int temp;
+    if (access_running( ))
+    {
+        temp = pthread_setaffinity_np(thread_id, CpuSet::native_size(), &cpus.native());
+        sysexcept(temp != 0, "pthread_setaffinity_np", temp);
+    }
+    else
+    {
+        temp = pthread_attr_setaffinity_np(&attributes, CpuSet::native_size(), &cpus.native());
+        sysexcept(temp != 0, "pthread_attr_setaffinity_np", temp);
+    }
+}
+
+CpuSet Thread::get_affinity( ) const
+{
+    cpu_set_t set;
+    int temp;
+    if (access_running( ))
+    {
+        temp = pthread_getaffinity_np(thread_id, sizeof(set), &set);
+        sysexcept(temp != 0, "pthread_getaffinity_np", temp);
+    }
+    else
+    {
+        temp = pthread_attr_getaffinity_np(&attributes, sizeof(set), &set);
+        sysexcept(temp != 0, "pthread_attr_getaffinity_np", temp);
+    }
+
+    return CpuSet(set);
+}
+
+void Thread::set_scheduling(policy_t policy, int priority)
+{
+    int native_policy;
+    switch (policy)
+    {
+        case OTHER:
+            native_policy = SCHED_OTHER;
+            break;
+        case FIFO:
+            native_policy = SCHED_FIFO;
+            break;
+        case RR:
+            native_policy = SCHED_RR;
+            break;
+        case BATCH:
+            native_policy = SCHED_BATCH;
+            break;
+        case IDLE:
+            native_policy = SCHED_IDLE;
+            break;
+        case DEADLINE:
+            throw std::invalid_argument(USE_SET_DEADLINE);
+        default:
+            throw std::invalid_argument(INVALID_POLICY);
+    }
+
+    const int min = sched_get_priority_min(native_policy);
+    const int max = sched_get_priority_max(native_policy);
+    if (priority < min || priority > max) throw std::invalid_argument(INVALID_PRIORITY);
+
+    struct sched_param param;
+    param.sched_priority = priority;
+
+    int temp;
+    if (access_running( ))
+    {
+        temp = pthread_setschedparam(thread_id, native_policy, &param);
+        schedexcept(temp != 0, "pthread_setschedparam", temp);
+    }
+    else
+    {
+        temp = pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+        sysexcept(temp != 0, "pthread_attr_setinheritsched", temp);
+
+        temp = pthread_attr_setschedpolicy(&attributes, native_policy);
+        sysexcept(temp != 0, "pthread_attr_setschedpolicy", temp);
+
+        temp = pthread_attr_setschedparam(&attributes, &param);
+        sysexcept(temp != 0, "pthread_attr_setschedparam", temp);
+
+        // replaces a previously set deadline policy
+        startup.set_deadline = false;
+    }
+}
+
+void Thread::set_deadline(const struct timespec &runtime, const struct timespec &deadline,
+        const struct timespec &period)
+{
+    const std::uint64_t runtime_ns = to_ns(runtime);
+    const std::uint64_t deadline_ns = to_ns(deadline);
+    const std::uint64_t period_ns = to_ns(period);
+
+    if (!runtime_ns || runtime_ns > deadline_ns || deadline_ns > period_ns)
+        throw std::invalid_argument(INVALID_DEADLINE);
+
+    if (access_running( ))
+    {
+        schedexcept(set_sched_deadline(get_tid( ), runtime_ns, deadline_ns, period_ns), "sched_setattr", errno);
+    }
+    else
+    {
+        startup.set_deadline = true;
+        startup.runtime = runtime_ns;
+        startup.deadline = deadline_ns;
+        startup.period = period_ns;
+    }
+}
+
+void Thread::set_nice(int nice)
+{
+    if (nice < -20 || nice > 19) throw std::invalid_argument(INVALID_NICE);
+
+    if (access_running( ))
+    {
+        schedexcept(setpriority(PRIO_PROCESS, static_cast<id_t>(get_tid( )), nice), "setpriority", errno);
+    }
+    else
+    {
+        startup.set_nice = true;
+        startup.nice = nice;
+    }
+}
+
+Thread::policy_t Thread::get_policy( ) const
+{
+    int native_policy;
+    int temp;
+    if (access_running( ))
+    {
+        struct sched_param param;
+        temp = pthread_getschedparam(thread_id, &native_policy, &param);
+        sysexcept(temp != 0, "pthread_getschedparam", temp);
+    }
+    else
+    {
+        if (startup.set_deadline) return DEADLINE;
+
+        temp = pthread_attr_getschedpolicy(&attributes, &native_policy);
+        sysexcept(temp != 0, "pthread_attr_getschedpolicy", temp);
+    }
+
+    switch (native_policy)
+    {
+        case SCHED_FIFO:
+            return FIFO;
+        case SCHED_RR:
+            return RR;
+        case SCHED_BATCH:
+            return BATCH;
+        case SCHED_IDLE:
+            return IDLE;
+        case SCHED_DEADLINE:
+            return DEADLINE;
+        default:
+            return OTHER;
+    }
+}
+
+int Thread::get_priority( ) const
+{
+    struct sched_param param;
+    int temp;
+    if (access_running( ))
+    {
+        int native_policy;
+        temp = pthread_getschedparam(thread_id, &native_policy, &param);
+        sysexcept(temp != 0, "pthread_getschedparam", temp);
+    }
+    else
+    {
+        temp = pthread_attr_getschedparam(&attributes, &param);
+        sysexcept(temp != 0, "pthread_attr_getschedparam", temp);
+    }
+
+    return param.sched_priority;
+}
+
+int Thread::get_nice( )
+{
+    const bool active = access_running( );
+    if (!active && startup.set_nice) return startup.nice;
+
+    // -1 is a valid nice value: errno has to be checked
+    const id_t id = active ? static_cast<id_t>(get_tid( )) : 0;
+    errno = 0;
+    const int nice = getpriority(PRIO_PROCESS, id);
+    sysexcept(nice == -1 && errno != 0, "getpriority", errno);
+
+    return nice;
+}
+
+pid_t Thread::get_tid( ) noexcept
+{
+    // published by the started thread before the startup completes
+    wait_callable_taken( );
+    return tid;
+}
+
+void Thread::set_name(const std::string &name)
+{
+    if (name.size() > NAME_MAX_LENGTH) throw std::invalid_argument(NAME_TOO_LONG);
+
+    if (access_running( ))
+    {
+        // the started thread might still read the name
+        wait_callable_taken( );
+
+        int temp = pthread_setname_np(thread_id, name.c_str( ));
+        sysexcept(temp != 0, "pthread_setname_np", temp);
+    }
+
+    std::strcpy(this->name, name.c_str( ));
+}
+
+std::string Thread::get_name( ) const
+{
+    if (!access_running( )) return name;
+
+    // the started thread applies the name before it takes the callable
+    const int state = callable_state.load(std::memory_order_acquire);
+    if (state == CALLABLE_STARTED || state == CALLABLE_WAITING) return name;
+
+    char thread_name[NAME_MAX_LENGTH + 1];
+    int temp = pthread_getname_np(thread_id, thread_name, sizeof(thread_name));
+    sysexcept(temp != 0, "pthread_getname_np", temp);
+
+    return thread_name;
+}
+
+struct timespec Thread::get_cpu_time( ) const
+{
+    if (!access_running( )) throw std::logic_error(CPU_TIME_STOPPED);
+
+    clockid_t clock;
+    int temp = pthread_getcpuclockid(thread_id, &clock);
+    sysexcept(temp != 0, "pthread_getcpuclockid", temp);
+
+    struct timespec time;
+    sysexcept(clock_gettime(clock, &time), "clock_gettime", errno);
+    return time;
+}
+
+void Thread::set_my_name(const std::string &name)
+{
+    if (name.size() > NAME_MAX_LENGTH) throw std::invalid_argument(NAME_TOO_LONG);
+
+    int temp = pthread_setname_np(pthread_self( ), name.c_str( ));
+    sysexcept(temp != 0, "pthread_setname_np", temp);
+}
+
+struct timespec Thread::get_my_cpu_time( )
+{
+    struct timespec time;
+    sysexcept(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time), "clock_gettime", errno);
+    return time;
+}
+
+std::vector<Thread::thread_info_t> Thread::get_threads( )
+{
+    const auto samples = thread_registry_snapshot( );
+
+    std::vector<thread_info_t> threads;
+    threads.reserve(samples.size());
+    for (const auto &sample : samples)
+    {
+        thread_info_t info;
+        info.tid = sample.tid;
+        info.cpu_time = sample.cpu_time;
+
+        // threads that terminated since the snapshot are not listed
+        if (read_task_stat(sample.tid, info.name, info.state)) threads.push_back(std::move(info));
+    }
+
+    return threads;
+}
+
+StopToken Thread::get_my_stop_token( ) noexcept
+{
+    return registration.stop_token;
+}
+
+bool Thread::access_running( ) const
+{
+    if (running && detachstate == DETACHED) throw std::logic_error(DETACHED_ACCESS);
+    return running;
+}
+
+void Thread::check_stack_changeable( ) const
+{
+    if (running) throw std::logic_error(STACK_RUNNING);
+}
+
+void Thread::release_stack( ) noexcept
+{
+    if (!stack_pool) return;
+
+    // a stack in use is abandoned (it stays acquired)
+    if (!stack_in_use)
+    {
+        try
+        {
+            stack_pool->release(stack);
+        }
+        catch (const std::exception &e)
+        {
+            *error_stream << __PRETTY_FUNCTION__ << ": failed to release the stack: " << e.what() << std::endl;
+        }
+    }
+
+    stack = nullptr;
+    stack_pool = nullptr;
+}
+
+void Thread::set_stack_size(std::size_t size)
+{
+    check_stack_changeable( );
+
+    // the stack address set by pthread_attr_setstack refers to the old size
+    if (stack) throw std::logic_error(STACK_SIZE_FIXED);
+
+    int temp = pthread_attr_setstacksize(&attributes, size);
+    sysexcept(temp != 0, "pthread_attr_setstacksize", temp);
+}
+
+void Thread::set_guard_size(std::size_t size)
+{
+    check_stack_changeable( );
+
+    int temp = pthread_attr_setguardsize(&attributes, size);
+    sysexcept(temp != 0, "pthread_attr_setguardsize", temp);
+}
+
+void Thread::set_stack(void *stack, std::size_t size)
+{
+    check_stack_changeable( );
+
+    int temp = pthread_attr_setstack(&attributes, stack, size);
+    sysexcept(temp != 0, "pthread_attr_setstack", temp);
+
+    release_stack( );
+    this->stack = stack;
+}
+
+void Thread::set_stack(StackPool &pool)
+{
+    check_stack_changeable( );
+
+    void *new_stack = pool.acquire( );
+    int temp = pthread_attr_setstack(&attributes, new_stack, pool.get_stack_size( ));
+    if (temp != 0)
+    {
+        pool.release(new_stack);
+        sysexcept(true, "pthread_attr_setstack", temp);
+    }
+
+    release_stack( );
+    stack = new_stack;
+    stack_pool = &pool;
+    stack_in_use = false;
+}
+
+std::size_t Thread::get_stack_size( ) const
+{
+    std::size_t size;
+    int temp = pthread_attr_getstacksize(&attributes, &size);
+    sysexcept(temp != 0, "pthread_attr_getstacksize", temp);
+    return size;
+}
+
+std::size_t Thread::get_guard_size( ) const
+{
+    std::size_t size;
+    int temp = pthread_attr_getguardsize(&attributes, &size);
+    sysexcept(temp != 0, "pthread_attr_getguardsize", temp);
+    return size;
+}
+
+void Thread::set_my_affinity(const CpuSet &cpus)
+{
+    if (cpus.empty()) throw std::invalid_argument(EMPTY_CPU_SET);
+
+    int temp = pthread_setaffinity_np(pthread_self(), CpuSet::native_size(), &cpus.native());
+    sysexcept(temp != 0, "pthread_setaffinity_np", temp);
+}
+
+CpuSet Thread::get_my_affinity( )
+{
+    cpu_set_t set;
+    int temp = pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+    sysexcept(temp != 0, "pthread_getaffinity_np", temp);
+
+    return CpuSet(set);
+}
+
 std::ostream& operator <<(std::ostream &os, de::Koesling::Threading::Thread::detachstate_t ds)
 {
     switch(ds)
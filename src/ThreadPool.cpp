@@ -0,0 +1,357 @@
+/*
+ * \file ThreadPool.cpp
+ * \brief Source file de::Koesling::Threading::ThreadPool
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "ThreadPool.hpp"
+
+#include "sysexcept.hpp"
+#include "destructor_exception.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <cerrno>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <sysexits.h>
+
+
+// -------------------- error messages ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+//! error message: submit to a pool that is shut down
+#define POOL_STOPPED std::string(__PRETTY_FUNCTION__) + ": The thread pool is shut down."
+
+//! error message: empty task
+#define EMPTY_TASK std::string(__PRETTY_FUNCTION__) + ": The task must not be empty."
+
+
+// -------------------- General constants and definitions --------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#define NSEC_PER_SEC 1000000000ULL
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+// -------------------- Initialize static attributes -------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+std::ostream* ThreadPool::error_stream = &std::cerr;
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(unsigned int thread_count, std::size_t queue_capacity) :
+        queue(queue_capacity),
+        queue_head(0),
+        queue_depth(0),
+        active_tasks(0),
+        stopping(false),
+        stopped(false),
+        joined(false),
+        start_time_ns(now_ns()),
+        worker_data(new worker_t[thread_count])
+{
+    if (!thread_count) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": a thread pool without threads is pointless.");
+
+    if (!queue_capacity) throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+            ": the queue capacity must not be 0.");
+
+    workers.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i)
+    {
+        worker_data[i].tasks_executed.store(0, std::memory_order_relaxed);
+        worker_data[i].busy_time_ns.store(0, std::memory_order_relaxed);
+    }
+
+    std::size_t started = 0;
+    try
+    {
+        for (std::size_t i = 0; i < thread_count; ++i)
+        {
+            workers.emplace_back([this, i]( ) { worker(i); });
+            workers.back().start();
+            started++;
+        }
+    }
+    catch (...)
+    {
+        // stop the workers that were already started (the destructor is not called)
+        workers.erase(workers.begin() + static_cast<std::ptrdiff_t>(started), workers.end());
+        shutdown();
+        throw;
+    }
+}
+
+
+// -------------------- Destructor -------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+ThreadPool::~ThreadPool( )
+{
+    try
+    {
+        shutdown();
+    }
+    catch (const std::system_error &e)
+    {
+        // worker threads might still access the object --> terminate
+        destructor_exception_terminate(e, *error_stream, EX_OSERR);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+unsigned long long ThreadPool::now_ns( )
+{
+    struct timespec now;
+    sysexcept(clock_gettime(CLOCK_MONOTONIC, &now), "clock_gettime", errno);
+
+    return static_cast<unsigned long long>(now.tv_sec) * NSEC_PER_SEC + static_cast<unsigned long long>(now.tv_nsec);
+}
+
+void ThreadPool::worker(std::size_t index)
+{
+    worker_t &data = worker_data[index];
+
+    mutex.lock();
+    while (true)
+    {
+        not_empty.wait(mutex, [this]( ) { return queue_depth != 0 || stopping; });
+
+        // stopping and no more tasks
+        if (queue_depth == 0) break;
+
+        task_t task = std::move(queue[queue_head]);
+        queue[queue_head] = nullptr;
+        queue_head = (queue_head + 1) % queue.size();
+        queue_depth--;
+        active_tasks++;
+
+        mutex.unlock();
+        not_full.signal();
+
+        const unsigned long long begin = now_ns();
+        try
+        {
+            task();
+        }
+        catch (const std::exception &e)
+        {
+            *error_stream << __PRETTY_FUNCTION__ << ": Exception of type " << typeid(e).name()
+                    << " thrown by task:" << std::endl << "    " << e.what() << std::endl;
+        }
+        catch (...)
+        {
+            *error_stream << __PRETTY_FUNCTION__ << ": Unknown exception thrown by task." << std::endl;
+        }
+        task = nullptr;
+
+        // only written by this worker
+        data.busy_time_ns.store(data.busy_time_ns.load(std::memory_order_relaxed) + now_ns() - begin,
+                std::memory_order_relaxed);
+        data.tasks_executed.store(data.tasks_executed.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+
+        mutex.lock();
+        active_tasks--;
+
+        if (queue_depth == 0 && active_tasks == 0) idle.broadcast();
+    }
+    mutex.unlock();
+}
+
+void ThreadPool::enqueue(task_t &&task)
+{
+    queue[(queue_head + queue_depth) % queue.size()] = std::move(task);
+    queue_depth++;
+
+    mutex.unlock();
+    not_empty.signal();
+}
+
+void ThreadPool::submit(task_t task)
+{
+    if (!task) throw std::invalid_argument(EMPTY_TASK);
+
+    mutex.lock();
+    try
+    {
+        not_full.wait(mutex, [this]( ) { return queue_depth < queue.size() || stopping; });
+        if (stopping) throw std::logic_error(POOL_STOPPED);
+    }
+    catch (...)
+    {
+        mutex.unlock();
+        throw;
+    }
+
+    enqueue(std::move(task));
+}
+
+bool ThreadPool::try_submit(task_t task)
+{
+    if (!task) throw std::invalid_argument(EMPTY_TASK);
+
+    mutex.lock();
+    if (stopping)
+    {
+        mutex.unlock();
+        throw std::logic_error(POOL_STOPPED);
+    }
+
+    if (queue_depth == queue.size())
+    {
+        mutex.unlock();
+        return false;
+    }
+
+    enqueue(std::move(task));
+    return true;
+}
+
+bool ThreadPool::timed_submit(task_t task, const timespec &time)
+{
+    if (!task) throw std::invalid_argument(EMPTY_TASK);
+
+    mutex.lock();
+    try
+    {
+        if (!not_full.wait_for(mutex, time, [this]( ) { return queue_depth < queue.size() || stopping; }))
+        {
+            mutex.unlock();
+            return false;
+        }
+
+        if (stopping) throw std::logic_error(POOL_STOPPED);
+    }
+    catch (...)
+    {
+        mutex.unlock();
+        throw;
+    }
+
+    enqueue(std::move(task));
+    return true;
+}
+
+void ThreadPool::drain( )
+{
+    mutex.lock();
+    try
+    {
+        idle.wait(mutex, [this]( ) { return queue_depth == 0 && active_tasks == 0; });
+    }
+    catch (...)
+    {
+        mutex.unlock();
+        throw;
+    }
+    mutex.unlock();
+}
+
+void ThreadPool::shutdown( )
+{
+    mutex.lock();
+    if (stopped)
+    {
+        // another thread joins the workers: wait until it is done
+        try
+        {
+            terminated.wait(mutex, [this]( ) { return joined; });
+        }
+        catch (...)
+        {
+            mutex.unlock();
+            throw;
+        }
+        mutex.unlock();
+        return;
+    }
+    stopping = true;
+    stopped = true;
+    mutex.unlock();
+
+    // wake all workers and all threads waiting in submit()
+    not_empty.broadcast();
+    not_full.broadcast();
+
+    // the workers execute the queued tasks before they terminate
+    try
+    {
+        for (auto &thread : workers)
+            thread.join();
+    }
+    catch (...)
+    {
+        // the other callers must not wait forever
+        mutex.lock();
+        joined = true;
+        mutex.unlock();
+        terminated.broadcast();
+        throw;
+    }
+
+    mutex.lock();
+    joined = true;
+    mutex.unlock();
+    terminated.broadcast();
+}
+
+std::size_t ThreadPool::get_queue_depth( )
+{
+    mutex.lock();
+    std::size_t value = queue_depth;
+    mutex.unlock();
+
+    return value;
+}
+
+std::size_t ThreadPool::get_active_tasks( )
+{
+    mutex.lock();
+    std::size_t value = active_tasks;
+    mutex.unlock();
+
+    return value;
+}
+
+ThreadPool::worker_stats_t ThreadPool::get_worker_stats(std::size_t index) const
+{
+    if (index >= workers.size()) throw std::out_of_range(std::string(__PRETTY_FUNCTION__) +
+            ": invalid worker index.");
+
+    worker_stats_t stats;
+    stats.tasks_executed = worker_data[index].tasks_executed.load(std::memory_order_relaxed);
+    stats.busy_time_ns = worker_data[index].busy_time_ns.load(std::memory_order_relaxed);
+
+    const unsigned long long lifetime = now_ns() - start_time_ns;
+    stats.utilization = lifetime ? static_cast<double>(stats.busy_time_ns) / static_cast<double>(lifetime) : 0.0;
+
+    return stats;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,196 @@
+/*
+ * \file Topology.cpp
+ * \brief Source file de::Koesling::Threading::Topology
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+// -------------------- non standard library includes ------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include "Topology.hpp"
+
+
+// -------------------- standard library includes ----------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <fstream>
+#include <sched.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+
+// -------------------- error messages ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+//! error message: invalid placement
+#define INVALID_PLACEMENT std::string(__PRETTY_FUNCTION__) + ": placement is invalid."
+
+
+// -------------------- General constants and definitions --------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+#define SYSFS_CPU "/sys/devices/system/cpu/"
+#define SYSFS_NODE "/sys/devices/system/node/"
+
+//! maximum number of cache indices per CPU (sysfs cache/indexN)
+#define MAX_CACHE_INDEX 16
+
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! read the first line of a sysfs file
+ *
+ * return value: false if the file can not be read
+ */
+static bool read_sysfs(const std::string &path, std::string &value)
+{
+    std::ifstream file(path);
+    if (!file) return false;
+    return static_cast<bool>(std::getline(file, value));
+}
+
+/*! read a CPU list from a sysfs file
+ *
+ * return value: false if the file can not be read or does not contain a valid list
+ */
+static bool read_sysfs_list(const std::string &path, CpuSet &set)
+{
+    std::string value;
+    if (!read_sysfs(path, value)) return false;
+
+    try
+    {
+        set = CpuSet::from_list(value);
+    }
+    catch (const std::invalid_argument &)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+// -------------------- Constructor(s) ---------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+Topology::Topology( )
+{
+    if (!read_sysfs_list(SYSFS_CPU "online", online) || online.empty())
+    {
+        // sysfs not available: CPUs 0 ... n-1
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+        if (count < 1) count = 1;
+        for (long cpu = 0; cpu < count && cpu < CPU_SETSIZE; ++cpu)
+            online.add(static_cast<unsigned int>(cpu));
+    }
+
+    // CPUs that are not allowed (cgroup cpuset, taskset) are not used. The kernel never reports an empty affinity.
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    {
+        const CpuSet usable = online & CpuSet(allowed);
+        if (!usable.empty()) online = usable;
+    }
+
+    for (auto cpu : online.get_cpus())
+    {
+        const std::string cpu_path = SYSFS_CPU "cpu" + std::to_string(cpu) + '/';
+
+        cpus.push_back(CpuSet {cpu});
+
+        // physical core: SMT siblings (core_cpus_list on newer kernels)
+        CpuSet core;
+        if (!read_sysfs_list(cpu_path + "topology/core_cpus_list", core) &&
+                !read_sysfs_list(cpu_path + "topology/thread_siblings_list", core)) core = CpuSet {cpu};
+        add_group(cores, core);
+
+        // L3 cache domain, fallback: package
+        CpuSet l3;
+        bool l3_found = false;
+        for (unsigned int index = 0; index < MAX_CACHE_INDEX && !l3_found; ++index)
+        {
+            const std::string cache_path = cpu_path + "cache/index" + std::to_string(index) + '/';
+
+            std::string level;
+            if (!read_sysfs(cache_path + "level", level)) break;
+            if (level == "3") l3_found = read_sysfs_list(cache_path + "shared_cpu_list", l3);
+        }
+        if (!l3_found && !read_sysfs_list(cpu_path + "topology/package_cpus_list", l3) &&
+                !read_sysfs_list(cpu_path + "topology/core_siblings_list", l3)) l3 = online;
+        add_group(l3_domains, l3);
+    }
+
+    // NUMA nodes
+    CpuSet node_ids;
+    if (read_sysfs_list(SYSFS_NODE "online", node_ids))
+    {
+        for (auto node : node_ids.get_cpus())
+        {
+            CpuSet node_cpus;
+            if (read_sysfs_list(SYSFS_NODE "node" + std::to_string(node) + "/cpulist", node_cpus))
+                add_group(nodes, node_cpus);
+        }
+    }
+
+    // CPUs that are not part of any node (or no NUMA information): one node for the remaining CPUs
+    CpuSet assigned;
+    for (const auto &node : nodes)
+        assigned = assigned | node;
+
+    if (assigned != online)
+    {
+        CpuSet remaining;
+        for (auto cpu : online.get_cpus())
+            if (!assigned.contains(cpu)) remaining.add(cpu);
+        add_group(nodes, remaining);
+    }
+}
+
+
+// -------------------- Methods ----------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+
+void Topology::add_group(std::vector<CpuSet> &groups, const CpuSet &set) const
+{
+    const CpuSet group = set & online;
+    if (group.empty()) return;
+
+    if (std::find(groups.begin(), groups.end(), group) == groups.end()) groups.push_back(group);
+}
+
+const std::vector<CpuSet>& Topology::get_groups(placement_t placement) const
+{
+    switch (placement)
+    {
+        case PER_CPU:
+            return cpus;
+        case PER_CORE:
+            return cores;
+        case PER_L3:
+            return l3_domains;
+        case PER_NODE:
+            return nodes;
+        default:
+            throw std::invalid_argument(INVALID_PLACEMENT);
+    }
+}
+
+const CpuSet& Topology::place(std::size_t thread_index, placement_t placement) const
+{
+    const auto &groups = get_groups(placement);
+    return groups[thread_index % groups.size()];
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
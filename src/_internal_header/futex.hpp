@@ -0,0 +1,125 @@
+/*
+ * \file futex.hpp
+ * \brief Thin wrappers around the linux futex system call
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "std::atomic<int> can not be used as futex word.");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "std::atomic<int> can not be used as futex word.");
+
+//! number of iterations a thread spins before it is suspended by the kernel
+constexpr unsigned int SPIN_COUNT = 100;
+
+/*! \brief Suspend the calling thread as long as word contains the value expected.
+ *
+ * attributes:
+ *      - word    : futex word
+ *      - expected: value the futex word is compared with
+ *      - deadline: absolute time point for timeout (nullptr: no timeout)
+ *      - realtime: true : deadline refers to CLOCK_REALTIME
+ *                  false: deadline refers to CLOCK_MONOTONIC
+ *
+ * return value:
+ *      true : woken up, word did not contain the expected value or interrupted by a signal
+ *             (the caller must re-check the condition it is waiting for)
+ *      false: deadline expired
+ *
+ * possible throws:
+ *      - std::system_error: the system call failed
+ */
+bool futex_wait(std::atomic<int> &word, int expected, const timespec *deadline = nullptr, bool realtime = false);
+
+/*! \brief Wake up to count threads waiting on word.
+ *
+ * return value: number of woken threads
+ *
+ * possible throws:
+ *      - std::system_error: the system call failed
+ */
+int futex_wake(std::atomic<int> &word, int count);
+
+/*! \brief Wake up to wake_count threads waiting on word and move up to requeue_count of the remaining waiters to
+ *         the futex target.
+ *
+ * The operation is only performed if word contains the value expected.
+ *
+ * return value:
+ *      true : success
+ *      false: word did not contain the value expected
+ *
+ * possible throws:
+ *      - std::system_error: the system call failed
+ */
+bool futex_requeue(std::atomic<int> &word, int expected, int wake_count, int requeue_count,
+        std::atomic<int> &target);
+
+/*! \brief Lock a futex based lock
+ *
+ * lock word: 0: unlocked
+ *            1: locked
+ *            2: locked, threads might be waiting
+ */
+inline void futex_lock(std::atomic<int> &lock_word)
+{
+    int value = 0;
+    if (lock_word.compare_exchange_strong(value, 1, std::memory_order_acquire, std::memory_order_relaxed)) return;
+
+    if (value != 2) value = lock_word.exchange(2, std::memory_order_acquire);
+    while (value != 0)
+    {
+        futex_wait(lock_word, 2);
+        value = lock_word.exchange(2, std::memory_order_acquire);
+    }
+}
+
+/*! \brief Lock a futex based lock, assuming that other threads are waiting for it
+ *
+ * Must be used by threads that might have been requeued to the lock word, so that the next waiter is woken when
+ * the lock is released.
+ */
+inline void futex_lock_contended(std::atomic<int> &lock_word)
+{
+    while (lock_word.exchange(2, std::memory_order_acquire) != 0)
+        futex_wait(lock_word, 2);
+}
+
+//! Unlock a futex based lock
+inline void futex_unlock(std::atomic<int> &lock_word)
+{
+    if (lock_word.fetch_sub(1, std::memory_order_release) != 1)
+    {
+        lock_word.store(0, std::memory_order_release);
+        futex_wake(lock_word, 1);
+    }
+}
+
+//! Hint to the processor that the calling thread is spinning
+inline void cpu_relax( ) noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -12,6 +12,7 @@
  *
  */
 
+#include <semaphore.h>
 #include <sys/time.h>
 
 namespace de {
@@ -20,6 +21,22 @@ namespace Threading {
 
 timespec pthread_timeout(const timespec& ts);
 
+//! Calculate the absolute time point (CLOCK_MONOTONIC) for a timeout of the time span ts
+timespec monotonic_timeout(const timespec& ts);
+
+/*! \brief Wait for a POSIX semaphore for at most the time span ts
+ *
+ * Uses sem_clockwait with CLOCK_MONOTONIC (glibc 2.30 or newer), so the timeout is not affected by changes of the
+ * system time. Older C libraries only provide sem_timedwait, which measures the timeout with CLOCK_REALTIME.
+ *
+ * return value: false if the time span expired
+ *
+ * possible throws:
+ *      - std::invalid_argument: time span is invalid
+ *      - std::system_error    : a system call failed
+ */
+bool sem_wait_for(sem_t *sem, const timespec& ts);
+
 } /* namespace Threading */
 } /* namespace Koesling */
 } /* namespace de */
@@ -0,0 +1,78 @@
+/*
+ * \file thread_registry.hpp
+ * \brief Registry of the threads started by de::Koesling::Threading::Thread
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <ctime>
+#include <sys/types.h>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+//! entry of a thread in the registry (intrusive doubly linked list, owned by the registered thread)
+struct thread_registry_entry_t
+{
+    //! previous entry
+    thread_registry_entry_t *prev;
+    //! next entry
+    thread_registry_entry_t *next;
+    //! kernel thread id
+    pid_t tid;
+    //! CPU time clock of the thread
+    clockid_t clock;
+};
+
+//! kernel thread id and CPU time of a registered thread
+struct thread_registry_sample_t
+{
+    //! kernel thread id
+    pid_t tid;
+    //! consumed CPU time
+    struct timespec cpu_time;
+};
+
+/*! \brief Add the calling thread to the registry
+ *
+ * The entry must stay valid until thread_registry_remove is called.
+ *
+ * possible throws:
+ *      - std::system_error: a system call failed
+ */
+void thread_registry_add(thread_registry_entry_t &entry);
+
+/*! \brief Remove an entry from the registry
+ *
+ * Must be called by the registered thread before it terminates (e.g. by the destructor of a thread_local object).
+ *
+ * possible throws:
+ *      - std::system_error: a system call failed
+ */
+void thread_registry_remove(thread_registry_entry_t &entry);
+
+/*! \brief Get thread id and CPU time of all registered threads
+ *
+ * The CPU time is read while the registry is locked, so all threads are still running.
+ *
+ * possible throws:
+ *      - std::system_error: a system call failed
+ *      - std::bad_alloc   : out of memory
+ */
+std::vector<thread_registry_sample_t> thread_registry_snapshot( );
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -0,0 +1,182 @@
+/*
+ * \file work_stealing_deque.hpp
+ * \brief Chase-Lev work-stealing deque
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+/*! \brief Dynamic circular work-stealing deque (Chase and Lev, memory orders as in Le et al. 2013)
+ *
+ * The owner thread pushes and takes elements at the bottom (LIFO), other threads steal elements from the top (FIFO).
+ * The buffer grows if it is full. Buffers that were replaced are kept until the deque is destroyed, because thieves
+ * might still read from them.
+ *
+ * template arguments:
+ *      - T: element type (pointer)
+ */
+template<typename T>
+class work_stealing_deque final
+{
+    private:
+        //! circular buffer
+        struct buffer_t
+        {
+            //! capacity - 1 (capacity is a power of 2)
+            std::int64_t mask;
+
+            //! elements
+            std::unique_ptr<std::atomic<T>[]> elements;
+
+            explicit buffer_t(std::int64_t capacity) :
+                    mask(capacity - 1),
+                    elements(new std::atomic<T>[static_cast<std::size_t>(capacity)])
+            { }
+
+            T load(std::int64_t index) const noexcept
+            {
+                return elements[static_cast<std::size_t>(index & mask)].load(std::memory_order_relaxed);
+            }
+
+            void store(std::int64_t index, T value) noexcept
+            {
+                elements[static_cast<std::size_t>(index & mask)].store(value, std::memory_order_relaxed);
+            }
+        };
+
+        /* top and bottom are separated by padding instead of alignas: the deque is part of heap allocated objects and
+         * operator new does not support extended alignment before C++17. Two members that are at least one cache line
+         * apart never share a cache line.
+         */
+
+        //! index of the oldest element (thieves)
+        std::atomic<std::int64_t> top;
+        char top_padding[64 - sizeof(std::atomic<std::int64_t>)];
+
+        //! index after the youngest element (owner)
+        std::atomic<std::int64_t> bottom;
+        char bottom_padding[64 - sizeof(std::atomic<std::int64_t>)];
+
+        //! current buffer
+        std::atomic<buffer_t*> buffer;
+
+        //! all buffers (owner only)
+        std::vector<std::unique_ptr<buffer_t>> buffers;
+
+    public:
+        //! result of steal()
+        enum steal_result_t
+        {
+            STOLEN, //!< an element was stolen
+            EMPTY,  //!< the deque is empty
+            ABORT   //!< lost the race against another thread, try again
+        };
+
+        explicit work_stealing_deque(std::int64_t capacity = 256) :
+                top(0),
+                bottom(0),
+                buffer(nullptr)
+        {
+            buffers.emplace_back(new buffer_t(capacity));
+            buffer.store(buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(work_stealing_deque &other) = delete;
+        work_stealing_deque& operator=(work_stealing_deque &other) = delete;
+
+        //! add an element at the bottom (owner only)
+        void push(T value)
+        {
+            const std::int64_t b = bottom.load(std::memory_order_relaxed);
+            const std::int64_t t = top.load(std::memory_order_acquire);
+            buffer_t *a = buffer.load(std::memory_order_relaxed);
+
+            if (b - t > a->mask)
+            {
+                // full: copy to a buffer of twice the size
+                buffers.emplace_back(new buffer_t((a->mask + 1) * 2));
+                buffer_t *grown = buffers.back().get();
+                for (std::int64_t i = t; i < b; ++i)
+                    grown->store(i, a->load(i));
+
+                buffer.store(grown, std::memory_order_release);
+                a = grown;
+            }
+
+            a->store(b, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        //! take the youngest element (owner only), nullptr: empty
+        T take( ) noexcept
+        {
+            const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            buffer_t *a = buffer.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // empty
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T value = a->load(b);
+            if (t == b)
+            {
+                // last element: race against the thieves
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    value = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            return value;
+        }
+
+        //! steal the oldest element (any thread)
+        steal_result_t steal(T &value) noexcept
+        {
+            std::int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b) return EMPTY;
+
+            buffer_t *a = buffer.load(std::memory_order_acquire);
+            value = a->load(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return ABORT;
+
+            return STOLEN;
+        }
+
+        //! check if the deque is empty (approximation if called concurrently)
+        bool empty( ) const noexcept
+        {
+            return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+        }
+};
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
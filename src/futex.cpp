@@ -0,0 +1,74 @@
+/*
+ * \file futex.cpp
+ * \brief Thin wrappers around the linux futex system call
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "futex.hpp"
+#include "sysexcept.hpp"
+
+#include <cerrno>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+//! the futex word of a std::atomic<int>
+static inline int* futex_address(std::atomic<int> &word) noexcept
+{
+    return reinterpret_cast<int*>(&word);
+}
+
+bool futex_wait(std::atomic<int> &word, int expected, const timespec *deadline, bool realtime)
+{
+    int op = FUTEX_WAIT_BITSET_PRIVATE;
+    if (realtime) op |= FUTEX_CLOCK_REALTIME;
+
+    auto temp = syscall(SYS_futex, futex_address(word), op, expected, deadline, nullptr, FUTEX_BITSET_MATCH_ANY);
+    if (temp != 0)
+    {
+        if (errno == ETIMEDOUT) return false;
+        if (errno == EAGAIN || errno == EINTR) return true;
+        sysexcept(true, "futex", errno);
+    }
+
+    return true;
+}
+
+int futex_wake(std::atomic<int> &word, int count)
+{
+    auto temp = syscall(SYS_futex, futex_address(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+    sysexcept(temp < 0, "futex", errno);
+
+    return static_cast<int>(temp);
+}
+
+bool futex_requeue(std::atomic<int> &word, int expected, int wake_count, int requeue_count,
+        std::atomic<int> &target)
+{
+    // the number of threads to requeue is passed instead of the timeout pointer
+    auto temp = syscall(SYS_futex, futex_address(word), FUTEX_CMP_REQUEUE_PRIVATE, wake_count,
+            static_cast<unsigned long>(requeue_count), futex_address(target), expected);
+    if (temp < 0)
+    {
+        if (errno == EAGAIN) return false;
+        sysexcept(true, "futex", errno);
+    }
+
+    return true;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
@@ -15,10 +15,19 @@
 #include "pthread_timeout.hpp"
 #include "sysexcept.hpp"
 #include <stdexcept>
+#include <ctime>
+#include <cerrno>
 
 #define NSEC_PER_SEC 1000000000
 #define NSEC_PER_USEC 1000
 
+// sem_clockwait is available since glibc 2.30
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#   if __GLIBC_PREREQ(2, 30)
+#       define HAVE_SEM_CLOCKWAIT
+#   endif
+#endif
+
 namespace de {
 namespace Koesling {
 namespace Threading {
@@ -47,6 +56,53 @@ timespec pthread_timeout(const timespec& ts)
     return timeout_time;
 }
 
+timespec monotonic_timeout(const timespec& ts)
+{
+    // verify time
+    if (ts.tv_sec < 0 || ts.tv_nsec < 0 || ts.tv_nsec >= NSEC_PER_SEC)
+        throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) + ": invalid timespec");
+
+    // create time for timeout
+    struct timespec timeout_time;
+    sysexcept(clock_gettime(CLOCK_MONOTONIC, &timeout_time), "clock_gettime", errno);
+
+    timeout_time.tv_sec += ts.tv_sec;
+    timeout_time.tv_nsec += ts.tv_nsec;
+
+    if (timeout_time.tv_nsec >= NSEC_PER_SEC)
+    {
+        timeout_time.tv_sec++;
+        timeout_time.tv_nsec -= NSEC_PER_SEC;
+    }
+
+    return timeout_time;
+}
+
+bool sem_wait_for(sem_t *sem, const timespec& ts)
+{
+#ifdef HAVE_SEM_CLOCKWAIT
+    const auto timeout_time = monotonic_timeout(ts);
+    auto wait = [&]( ) { return sem_clockwait(sem, CLOCK_MONOTONIC, &timeout_time); };
+    const char *function = "sem_clockwait";
+#else
+    const auto timeout_time = pthread_timeout(ts);
+    auto wait = [&]( ) { return sem_timedwait(sem, &timeout_time); };
+    const char *function = "sem_timedwait";
+#endif
+
+    int temp;
+    do temp = wait();
+    while (temp && errno == EINTR);
+
+    if (temp)
+    {
+        if (errno == ETIMEDOUT) return false;
+        sysexcept(true, function, errno);
+    }
+
+    return true;
+}
+
 } /* namespace Threading */
 } /* namespace Koesling */
 } /* namespace de */
@@ -0,0 +1,95 @@
+/*
+ * \file thread_registry.cpp
+ * \brief Registry of the threads started by de::Koesling::Threading::Thread
+ *
+ * required compiler options:
+ *          -std=c++11 (or higher)
+ *          -pthread
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "thread_registry.hpp"
+#include "futex.hpp"
+#include "sysexcept.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <ctime>
+#include <pthread.h>
+
+namespace de {
+namespace Koesling {
+namespace Threading {
+
+//! first registered thread
+static thread_registry_entry_t *registry_head = nullptr;
+
+//! number of registered threads
+static std::size_t registry_size = 0;
+
+//! protects registry_head and registry_size (futex lock word)
+static std::atomic<int> registry_lock(0);
+
+void thread_registry_add(thread_registry_entry_t &entry)
+{
+    int temp = pthread_getcpuclockid(pthread_self(), &entry.clock);
+    sysexcept(temp != 0, "pthread_getcpuclockid", temp);
+
+    entry.prev = nullptr;
+
+    futex_lock(registry_lock);
+    entry.next = registry_head;
+    if (registry_head) registry_head->prev = &entry;
+    registry_head = &entry;
+    registry_size++;
+    futex_unlock(registry_lock);
+}
+
+void thread_registry_remove(thread_registry_entry_t &entry)
+{
+    futex_lock(registry_lock);
+    if (entry.prev) entry.prev->next = entry.next;
+    else registry_head = entry.next;
+    if (entry.next) entry.next->prev = entry.prev;
+    registry_size--;
+    futex_unlock(registry_lock);
+}
+
+std::vector<thread_registry_sample_t> thread_registry_snapshot( )
+{
+    std::vector<thread_registry_sample_t> samples;
+
+    futex_lock(registry_lock);
+    try
+    {
+        samples.reserve(registry_size);
+
+        // the CPU time clock of a thread is only valid while the thread exists: registered threads can not
+        // terminate, because they have to remove their entry first
+        for (auto entry = registry_head; entry; entry = entry->next)
+        {
+            thread_registry_sample_t sample;
+            sample.tid = entry->tid;
+            sysexcept(clock_gettime(entry->clock, &sample.cpu_time), "clock_gettime", errno);
+            samples.push_back(sample);
+        }
+    }
+    catch (...)
+    {
+        futex_unlock(registry_lock);
+        throw;
+    }
+    futex_unlock(registry_lock);
+
+    return samples;
+}
+
+} /* namespace Threading */
+} /* namespace Koesling */
+} /* namespace de */
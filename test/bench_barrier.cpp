@@ -0,0 +1,82 @@
+/*
+ * \file bench_barrier.cpp
+ * \brief Benchmark: round trip time of Barrier::arrive_and_wait() for 2 - 128 threads (pthread_barrier_wait for
+ *        comparison)
+ *
+ * usage: bench_barrier [maximum threads (default: 128)] [rounds (default: 1000)]
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Barrier.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+/*! average time of one round in microseconds
+ *
+ * attributes:
+ *      - thread_count: number of participating threads (including the calling thread)
+ *      - rounds      : number of measured rounds
+ *      - wait        : arrive at the barrier and wait for the other threads
+ */
+template<typename Wait>
+double measure(unsigned int thread_count, unsigned int rounds, Wait wait)
+{
+    // the calling thread is one of the participants
+    std::vector<Thread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned int i = 1; i < thread_count; ++i)
+    {
+        threads.emplace_back([&]( )
+        {
+            for (unsigned int round = 0; round <= rounds; ++round)
+                wait();
+        });
+        threads.back().start();
+    }
+
+    // first round: all threads started
+    wait();
+
+    const auto start = test::steady_clock::now();
+    for (unsigned int round = 0; round < rounds; ++round)
+        wait();
+    const double elapsed = test::elapsed_us(start);
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return elapsed / rounds;
+}
+
+} /* namespace */
+
+int main(int argc, char **argv)
+{
+    const unsigned int max_threads = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 128;
+    const unsigned int rounds = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 1000;
+
+    for (unsigned int thread_count = 2; thread_count <= max_threads; thread_count *= 2)
+    {
+        Barrier barrier(thread_count);
+        const double barrier_us = measure(thread_count, rounds, [&]( ) { barrier.arrive_and_wait(); });
+
+        pthread_barrier_t pthread_barrier;
+        pthread_barrier_init(&pthread_barrier, nullptr, thread_count);
+        const double pthread_us = measure(thread_count, rounds, [&]( ) { pthread_barrier_wait(&pthread_barrier); });
+        pthread_barrier_destroy(&pthread_barrier);
+
+        std::cout << thread_count << " threads: Barrier " << barrier_us << " us, pthread_barrier " << pthread_us
+                << " us per round" << std::endl;
+    }
+}
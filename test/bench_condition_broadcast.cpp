@@ -0,0 +1,86 @@
+/*
+ * \file bench_condition_broadcast.cpp
+ * \brief Benchmark: latency of Condition::broadcast() until all waiters returned
+ *
+ * usage: bench_condition_broadcast [waiters (default: 256)] [rounds (default: 50)]
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Condition.hpp"
+#include "Mutex.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+int main(int argc, char **argv)
+{
+    const unsigned int waiters = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 256;
+    const unsigned int rounds = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 50;
+
+    Mutex mutex;
+    Condition condition;
+    unsigned int generation = 0;
+    std::atomic<unsigned int> arrived(0);
+    std::atomic<unsigned int> finished(0);
+    std::atomic<long> last_return(0);
+    const auto start = test::steady_clock::now();
+
+    std::vector<Thread> threads;
+    threads.reserve(waiters);
+    for (unsigned int i = 0; i < waiters; ++i)
+    {
+        threads.emplace_back([&]( )
+        {
+            for (unsigned int round = 0; round < rounds; ++round)
+            {
+                mutex.lock();
+                const unsigned int seen = generation;
+                arrived++;
+                condition.wait(mutex, [&]( ) { return generation != seen; });
+                mutex.unlock();
+
+                // the last waiter of the round stores the time
+                if (finished.fetch_add(1) + 1 == (round + 1) * waiters)
+                    last_return.store(static_cast<long>(test::elapsed_us(start) * 1e3));
+            }
+        });
+        threads.back().start();
+    }
+
+    std::vector<double> latencies;
+    for (unsigned int round = 0; round < rounds; ++round)
+    {
+        // all waiters are waiting once they released the mutex
+        test::spin_until([&]( ) { return arrived.load() == (round + 1) * waiters; });
+        mutex.lock();
+
+        const long broadcast_time = static_cast<long>(test::elapsed_us(start) * 1e3);
+        generation++;
+        condition.broadcast();
+        mutex.unlock();
+
+        test::spin_until([&]( ) { return finished.load() == (round + 1) * waiters; });
+        latencies.push_back(static_cast<double>(last_return.load() - broadcast_time) / 1e3);
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0;
+    for (auto latency : latencies)
+        sum += latency;
+
+    std::cout << "broadcast to " << waiters << " waiters (" << rounds << " rounds): until all returned: mean "
+            << sum / static_cast<double>(latencies.size()) << " us, median " << latencies[latencies.size() / 2]
+            << " us, min " << latencies.front() << " us" << std::endl;
+}
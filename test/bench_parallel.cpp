@@ -0,0 +1,108 @@
+/*
+ * \file bench_parallel.cpp
+ * \brief Benchmark: parallel_for, parallel_reduce and parallel_scan for 1e3 - 1e9 elements compared with serial loops
+ *
+ * usage: bench_parallel [maximum exponent (default: 9)] [maximum exponent of for/scan (default: 7)]
+ *
+ * parallel_reduce works on an index range (no memory). parallel_for and parallel_scan write one 32 bit value per
+ * element, 1e8 elements need 400 MB.
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Parallel.hpp"
+#include "test.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! element function (cheap, not reducible to a closed form)
+inline std::uint32_t element(std::size_t i)
+{
+    const auto value = static_cast<std::uint32_t>(i);
+    return value ^ (value >> 3);
+}
+
+//! print serial and parallel time of one measurement
+void report(const char *name, std::size_t size, double serial_us, double parallel_us)
+{
+    std::cout << name << " " << size << ": serial " << serial_us / 1e3 << " ms, parallel " << parallel_us / 1e3
+            << " ms (speedup " << serial_us / parallel_us << ")" << std::endl;
+}
+
+} /* namespace */
+
+int main(int argc, char **argv)
+{
+    const int max_exponent = argc > 1 ? std::atoi(argv[1]) : 9;
+    const int max_memory_exponent = argc > 2 ? std::atoi(argv[2]) : 7;
+
+    // a lambda (unlike a function pointer) is inlined like the serial loop
+    const auto map = [ ](std::size_t i) { return element(i); };
+
+    std::cout << Scheduler::get_default().get_thread_count() << " worker threads" << std::endl;
+
+    std::size_t size = 100;
+    for (int exponent = 3; exponent <= max_exponent; ++exponent)
+    {
+        size *= 10;
+
+        // parallel_reduce
+        auto start = test::steady_clock::now();
+        std::uint32_t serial_sum = 0;
+        for (std::size_t i = 0; i < size; ++i)
+            serial_sum += element(i);
+        double serial_us = test::elapsed_us(start);
+
+        start = test::steady_clock::now();
+        const std::uint32_t parallel_sum = parallel_reduce(std::size_t(0), size, std::uint32_t(0), map,
+                [ ](std::uint32_t a, std::uint32_t b) { return a + b; });
+        double parallel_us = test::elapsed_us(start);
+
+        CHECK(serial_sum == parallel_sum);
+        report("parallel_reduce", size, serial_us, parallel_us);
+
+        if (exponent > max_memory_exponent) continue;
+
+        // parallel_for
+        std::vector<std::uint32_t> serial_values(size);
+        std::vector<std::uint32_t> parallel_values(size);
+
+        start = test::steady_clock::now();
+        for (std::size_t i = 0; i < size; ++i)
+            serial_values[i] = element(i);
+        serial_us = test::elapsed_us(start);
+
+        start = test::steady_clock::now();
+        parallel_for(std::size_t(0), size, [&](std::size_t i) { parallel_values[i] = element(i); });
+        parallel_us = test::elapsed_us(start);
+
+        CHECK(serial_values == parallel_values);
+        report("parallel_for", size, serial_us, parallel_us);
+
+        // parallel_scan (in place)
+        start = test::steady_clock::now();
+        std::uint32_t prefix = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            prefix += serial_values[i];
+            serial_values[i] = prefix;
+        }
+        serial_us = test::elapsed_us(start);
+
+        start = test::steady_clock::now();
+        parallel_scan(parallel_values.begin(), parallel_values.end(), parallel_values.begin(), std::uint32_t(0),
+                [ ](std::uint32_t a, std::uint32_t b) { return a + b; });
+        parallel_us = test::elapsed_us(start);
+
+        CHECK(serial_values == parallel_values);
+        report("parallel_scan", size, serial_us, parallel_us);
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * \file bench_scheduler.cpp
+ * \brief Benchmark: work-stealing Scheduler (recursive fork-join and fan-out) compared with serial execution and
+ *        ThreadPool
+ *
+ * usage: bench_scheduler [worker threads (default: online processors)] [fib n (default: 30)]
+ *                        [fan-out tasks (default: 1000000)]
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Scheduler.hpp"
+#include "ThreadPool.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! below this n fib is computed serially (task granularity)
+constexpr unsigned int FIB_CUTOFF = 20;
+
+//! serial fibonacci (exponential on purpose: the work of a call is known)
+unsigned long fib_serial(unsigned int n)
+{
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+//! fibonacci with one task per call above FIB_CUTOFF, idle workers steal the older (larger) tasks
+unsigned long fib_tasks(Scheduler &scheduler, unsigned int n)
+{
+    if (n < FIB_CUTOFF) return fib_serial(n);
+
+    unsigned long a = 0;
+    unsigned long b = 0;
+    TaskGroup group(scheduler);
+    group.spawn([&]( ) { a = fib_tasks(scheduler, n - 1); });
+    b = fib_tasks(scheduler, n - 2);
+    group.wait();
+    return a + b;
+}
+
+} /* namespace */
+
+int main(int argc, char **argv)
+{
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    const unsigned int threads = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) :
+            static_cast<unsigned int>(online < 1 ? 1 : online);
+    const unsigned int n = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 30;
+    const unsigned int tasks = argc > 3 ? static_cast<unsigned int>(std::atoi(argv[3])) : 1000000;
+
+    Scheduler scheduler(threads);
+    std::cout << threads << " worker threads" << std::endl;
+
+    // recursive fork-join: the root task runs on a worker, the subtasks are stolen from its deque
+    auto start = test::steady_clock::now();
+    const unsigned long serial_result = fib_serial(n);
+    const double serial_us = test::elapsed_us(start);
+
+    unsigned long task_result = 0;
+    start = test::steady_clock::now();
+    {
+        TaskGroup root(scheduler);
+        root.spawn([&]( ) { task_result = fib_tasks(scheduler, n); });
+        root.wait();
+    }
+    const double task_us = test::elapsed_us(start);
+    CHECK(task_result == serial_result);
+
+    std::cout << "fib(" << n << "): serial " << serial_us / 1e3 << " ms, Scheduler " << task_us / 1e3
+            << " ms (speedup " << serial_us / task_us << ")" << std::endl;
+
+    // fan-out: many small tasks spawned by a worker (stolen by the others) and by an external thread (shared queue)
+    std::atomic<unsigned long> sum(0);
+    start = test::steady_clock::now();
+    {
+        TaskGroup root(scheduler);
+        root.spawn([&]( )
+        {
+            TaskGroup group(scheduler);
+            for (unsigned int i = 0; i < tasks; ++i)
+                group.spawn([&sum, i]( ) { sum.fetch_add(i, std::memory_order_relaxed); });
+            group.wait();
+        });
+        root.wait();
+    }
+    const double worker_spawn_us = test::elapsed_us(start);
+
+    start = test::steady_clock::now();
+    {
+        TaskGroup group(scheduler);
+        for (unsigned int i = 0; i < tasks; ++i)
+            group.spawn([&sum, i]( ) { sum.fetch_add(i, std::memory_order_relaxed); });
+        group.wait();
+    }
+    const double external_spawn_us = test::elapsed_us(start);
+
+    start = test::steady_clock::now();
+    {
+        ThreadPool pool(threads, 1024);
+        for (unsigned int i = 0; i < tasks; ++i)
+            pool.submit([&sum, i]( ) { sum.fetch_add(i, std::memory_order_relaxed); });
+        pool.drain();
+    }
+    const double pool_us = test::elapsed_us(start);
+
+    const unsigned long expected = static_cast<unsigned long>(tasks) * (tasks - 1) / 2 * 3;
+    CHECK(sum.load() == expected);
+
+    std::cout << tasks << " tasks: spawned by a worker " << worker_spawn_us * 1e3 / tasks << " ns/task, spawned by "
+            << "an external thread " << external_spawn_us * 1e3 / tasks << " ns/task, ThreadPool "
+            << pool_us * 1e3 / tasks << " ns/task" << std::endl;
+}
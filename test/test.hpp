@@ -0,0 +1,74 @@
+/*
+ * \file test.hpp
+ * \brief Helpers for the tests and benchmarks
+ *
+ * required compiler options:
+ *          -std=c++14 (or higher)
+ *
+ * recommended compiler options:
+ *          -O2
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sched.h>
+
+/*! check a condition, terminate the test with exit code 1 if it is false
+ *
+ * arguments:
+ *      - condition: checked condition
+ */
+#define CHECK(condition) do                                                                                            \
+{                                                                                                                      \
+    if (!(condition))                                                                                                  \
+    {                                                                                                                  \
+        std::cerr << __FILE__ << ':' << __LINE__ << ": check failed: " #condition << std::endl;                        \
+        std::exit(1);                                                                                                  \
+    }                                                                                                                  \
+}                                                                                                                      \
+while (false)
+
+namespace test {
+
+//! clock of all measurements
+typedef std::chrono::steady_clock steady_clock;
+
+//! elapsed time since start in microseconds
+inline double elapsed_us(steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(steady_clock::now() - start).count();
+}
+
+//! CPU time consumed by the calling thread in milliseconds
+inline double thread_cpu_ms( )
+{
+    struct timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) * 1e3 + static_cast<double>(time.tv_nsec) / 1e6;
+}
+
+//! wait until predicate returns true (yields the processor while waiting)
+template<typename Predicate>
+void spin_until(Predicate predicate)
+{
+    while (!predicate())
+        sched_yield();
+}
+
+//! time span of ms milliseconds
+inline struct timespec milliseconds(long ms)
+{
+    struct timespec time;
+    time.tv_sec = ms / 1000;
+    time.tv_nsec = ms % 1000 * 1000000;
+    return time;
+}
+
+} /* namespace test */
@@ -0,0 +1,225 @@
+/*
+ * \file test_condition_wakeups.cpp
+ * \brief Test: every restart of a Condition wakes exactly one thread that waited before it
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Condition.hpp"
+#include "Mutex.hpp"
+#include "StopToken.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! wait until predicate is true, at most timeout_ms milliseconds
+template<typename Predicate>
+bool settle(Predicate predicate, long timeout_ms = 5000)
+{
+    const auto start = test::steady_clock::now();
+    while (!predicate())
+    {
+        if (test::elapsed_us(start) > static_cast<double>(timeout_ms) * 1e3) return false;
+        sched_yield();
+    }
+    return true;
+}
+
+//! threads that wait (with predicate) until they were woken once, every wakeup is counted
+class Waiters
+{
+    private:
+        Mutex &mutex;
+        Condition &condition;
+        std::vector<Thread> threads;
+
+    public:
+        //! number of threads that are waiting (protected by mutex)
+        unsigned int arrived = 0;
+        //! number of wakeups (evaluations of the predicate after the first one)
+        std::atomic<unsigned int> wakeups;
+
+        Waiters(Mutex &mutex, Condition &condition, unsigned int count) :
+                mutex(mutex),
+                condition(condition),
+                wakeups(0)
+        {
+            threads.reserve(count);
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                threads.emplace_back([this]( )
+                {
+                    bool first = true;
+                    this->mutex.lock();
+                    arrived++;
+                    this->condition.wait(this->mutex, [&]( )
+                    {
+                        if (first)
+                        {
+                            first = false;
+                            return false;
+                        }
+                        wakeups++;
+                        return true;
+                    });
+                    this->mutex.unlock();
+                });
+                threads.back().start();
+            }
+
+            // all threads are queued once they released the mutex in wait
+            CHECK(settle([&]( )
+            {
+                this->mutex.lock();
+                const bool all = arrived == count;
+                this->mutex.unlock();
+                return all;
+            }));
+        }
+
+        void join( )
+        {
+            for (auto &thread : threads)
+                thread.join();
+        }
+};
+
+//! signal, notify(n) and broadcast wake exactly the requested number of threads
+void test_counts( )
+{
+    Mutex mutex;
+    Condition condition;
+    Waiters waiters(mutex, condition, 16);
+
+    mutex.lock();
+    CHECK(condition.signal());
+    mutex.unlock();
+    CHECK(settle([&]( ) { return waiters.wakeups.load() == 1; }));
+
+    mutex.lock();
+    CHECK(condition.notify(3) == 3);
+    mutex.unlock();
+    CHECK(settle([&]( ) { return waiters.wakeups.load() == 4; }));
+
+    mutex.lock();
+    CHECK(condition.broadcast());
+    mutex.unlock();
+    CHECK(settle([&]( ) { return waiters.wakeups.load() == 16; }));
+
+    waiters.join();
+    CHECK(waiters.wakeups.load() == 16);
+    CHECK(!condition.signal());
+    CHECK(condition.notify(5) == 0);
+    CHECK(!condition.broadcast());
+}
+
+//! random notifications: no wakeup is lost and no thread is woken without restart
+void test_stress( )
+{
+    std::srand(42);
+
+    for (unsigned int round = 0; round < 100; ++round)
+    {
+        Mutex mutex;
+        Condition condition;
+        const unsigned int count = 1 + static_cast<unsigned int>(std::rand() % 12);
+        Waiters waiters(mutex, condition, count);
+
+        unsigned int restarted = 0;
+        while (restarted < count)
+        {
+            const size_t n = static_cast<size_t>(std::rand() % 4);
+            mutex.lock();
+            const size_t result = condition.notify(n);
+            mutex.unlock();
+
+            CHECK(result == std::min(n, static_cast<size_t>(count - restarted)));
+            restarted += static_cast<unsigned int>(result);
+
+            // every restart has exactly one wakeup
+            CHECK(settle([&]( ) { return waiters.wakeups.load() == restarted; }));
+        }
+
+        waiters.join();
+        CHECK(waiters.wakeups.load() == count);
+    }
+}
+
+//! a thread that starts waiting after a signal is not restarted by it
+void test_late_arrival( )
+{
+    Mutex mutex;
+    Condition condition;
+    Waiters waiters(mutex, condition, 1);
+
+    mutex.lock();
+    CHECK(condition.signal());
+
+    // the restarted thread can not continue while the mutex is held, this thread must not take its restart
+    CHECK(!condition.wait(test::milliseconds(100)));
+    mutex.unlock();
+
+    waiters.join();
+    CHECK(waiters.wakeups.load() == 1);
+
+    // no waiting thread: the signal is lost
+    CHECK(!condition.signal());
+    CHECK(!condition.wait(test::milliseconds(50)));
+}
+
+//! a stop request restarts only the stopped thread
+void test_stop( )
+{
+    Mutex mutex;
+    Condition condition;
+    StopSource source;
+    std::atomic<int> result(-1);
+
+    Waiters waiters(mutex, condition, 2);
+
+    Thread stopped([&]( )
+    {
+        mutex.lock();
+        waiters.arrived++;
+        result = condition.wait(mutex, source.get_token(), [ ]( ) { return false; }) ? 1 : 0;
+        mutex.unlock();
+    });
+    stopped.start();
+    CHECK(settle([&]( )
+    {
+        mutex.lock();
+        const bool all = waiters.arrived == 3;
+        mutex.unlock();
+        return all;
+    }));
+
+    CHECK(source.request_stop());
+    stopped.join();
+    CHECK(result.load() == 0);
+    CHECK(waiters.wakeups.load() == 0);
+
+    mutex.lock();
+    CHECK(condition.notify(2) == 2);
+    mutex.unlock();
+    waiters.join();
+    CHECK(waiters.wakeups.load() == 2);
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_counts();
+    test_stress();
+    test_late_arrival();
+    test_stop();
+}
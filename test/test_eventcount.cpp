@@ -0,0 +1,58 @@
+/*
+ * \file test_eventcount.cpp
+ * \brief Test: EventCount waits and the number of waiting threads
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "EventCount.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace de::Koesling::Threading;
+
+int main( )
+{
+    EventCount event_count;
+
+    // notification after prepare_wait is not lost
+    auto key = event_count.prepare_wait();
+    CHECK(event_count.get_thread_queue() == 1);
+    event_count.notify();
+    CHECK(event_count.wait(key, test::milliseconds(1000)));
+    CHECK(event_count.get_thread_queue() == 0);
+
+    // timeout
+    key = event_count.prepare_wait();
+    CHECK(!event_count.wait(key, test::milliseconds(20)));
+    CHECK(event_count.get_thread_queue() == 0);
+
+    // an invalid time span does not leave the thread counted as waiting
+    struct timespec invalid;
+    invalid.tv_sec = 0;
+    invalid.tv_nsec = -1;
+    key = event_count.prepare_wait();
+    bool thrown = false;
+    try { event_count.wait(key, invalid); } catch (const std::invalid_argument &) { thrown = true; }
+    CHECK(thrown);
+    CHECK(event_count.get_thread_queue() == 0);
+
+    // a waiting thread is woken by notify_all
+    std::atomic<bool> woken(false);
+    Thread thread([&]( )
+    {
+        auto thread_key = event_count.prepare_wait();
+        event_count.wait(thread_key);
+        woken = true;
+    });
+    thread.start();
+    test::spin_until([&]( ) { return event_count.get_thread_queue() == 1; });
+    event_count.notify_all();
+    thread.join();
+    CHECK(woken.load());
+    CHECK(event_count.get_thread_queue() == 0);
+}
@@ -0,0 +1,138 @@
+/*
+ * \file test_events.cpp
+ * \brief Test: AutoResetEvent and ManualResetEvent waits, timeouts and the number of waiting threads
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "AutoResetEvent.hpp"
+#include "ManualResetEvent.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! number of threads that wait for the same event
+constexpr int WAITERS = 4;
+
+//! a time span with a negative number of nanoseconds
+struct timespec invalid_time( )
+{
+    struct timespec time;
+    time.tv_sec = 0;
+    time.tv_nsec = -1;
+    return time;
+}
+
+void test_manual_reset( )
+{
+    ManualResetEvent event;
+    CHECK(!event.is_set());
+
+    // a thread that timed out is no longer counted: the next set() does not wake anybody
+    CHECK(!event.timedwait(test::milliseconds(20)));
+    CHECK(event.get_thread_queue() == 0);
+
+    bool thrown = false;
+    try { event.timedwait(invalid_time()); } catch (const std::invalid_argument &) { thrown = true; }
+    CHECK(thrown);
+    CHECK(event.get_thread_queue() == 0);
+
+    // set() releases all waiting threads, the event stays set
+    std::atomic<int> released(0);
+    std::vector<std::unique_ptr<Thread>> waiters;
+    for (int i = 0; i < WAITERS; ++i)
+    {
+        waiters.emplace_back(new Thread([&, i]( )
+        {
+            if (i % 2) event.wait();
+            else if (!event.timedwait(test::milliseconds(60000))) return;
+            ++released;
+        }));
+        waiters.back()->start();
+    }
+
+    test::spin_until([&]( ) { return event.get_thread_queue() == WAITERS; });
+    CHECK(released.load() == 0);
+    event.set();
+    for (auto &waiter : waiters)
+        waiter->join();
+    CHECK(released.load() == WAITERS);
+    CHECK(event.get_thread_queue() == 0);
+
+    CHECK(event.is_set());
+    event.wait();
+    CHECK(event.timedwait(test::milliseconds(0)));
+
+    event.reset();
+    CHECK(!event.is_set());
+    CHECK(!event.timedwait(test::milliseconds(10)));
+
+    ManualResetEvent initially_set(true);
+    CHECK(initially_set.is_set());
+    CHECK(initially_set.timedwait(test::milliseconds(0)));
+}
+
+void test_auto_reset( )
+{
+    AutoResetEvent event;
+    CHECK(!event.trywait());
+    CHECK(!event.timedwait(test::milliseconds(20)));
+    CHECK(event.get_thread_queue() == 0);
+
+    bool thrown = false;
+    try { event.timedwait(invalid_time()); } catch (const std::invalid_argument &) { thrown = true; }
+    CHECK(thrown);
+    CHECK(event.get_thread_queue() == 0);
+
+    // the event is consumed by one thread
+    event.set();
+    CHECK(event.is_set());
+    CHECK(event.trywait());
+    CHECK(!event.is_set());
+    CHECK(!event.trywait());
+
+    // each set() releases exactly one waiting thread
+    std::atomic<int> released(0);
+    std::vector<std::unique_ptr<Thread>> waiters;
+    for (int i = 0; i < WAITERS; ++i)
+    {
+        waiters.emplace_back(new Thread([&]( )
+        {
+            event.wait();
+            ++released;
+        }));
+        waiters.back()->start();
+    }
+
+    test::spin_until([&]( ) { return event.get_thread_queue() == WAITERS; });
+    for (int i = 1; i <= WAITERS; ++i)
+    {
+        event.set();
+        test::spin_until([&]( ) { return released.load() == i; });
+        CHECK(event.get_thread_queue() == static_cast<unsigned int>(WAITERS - i));
+    }
+    for (auto &waiter : waiters)
+        waiter->join();
+    CHECK(!event.is_set());
+
+    AutoResetEvent initially_set(true);
+    CHECK(initially_set.timedwait(test::milliseconds(0)));
+    CHECK(!initially_set.is_set());
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_manual_reset();
+    test_auto_reset();
+}
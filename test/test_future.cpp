@@ -0,0 +1,198 @@
+/*
+ * \file test_future.cpp
+ * \brief Test: Future/Promise results, continuations and combinators
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Future.hpp"
+#include "Thread.hpp"
+#include "ThreadPool.hpp"
+#include "test.hpp"
+
+#include <future>
+#include <pthread.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+//! check that future.get() throws std::future_error with code
+template<typename T>
+static bool throws_future_error(Future<T> &future, std::future_errc code)
+{
+    try
+    {
+        future.get();
+    }
+    catch (const std::future_error &e)
+    {
+        return e.code() == code;
+    }
+    return false;
+}
+
+int main( )
+{
+    // value set by another thread
+    {
+        Promise<int> promise;
+        auto future = promise.get_future();
+        CHECK(future.valid());
+        CHECK(!future.is_ready());
+        CHECK(!future.wait_for(test::milliseconds(10)));
+
+        Thread thread([&]( ) { promise.set_value(42); });
+        thread.start();
+        CHECK(future.get() == 42);
+        CHECK(!future.valid());
+        thread.join();
+    }
+
+    // misuse is reported with std::future_error
+    {
+        Promise<int> promise;
+        auto future = promise.get_future();
+        bool thrown = false;
+        try { promise.get_future(); }
+        catch (const std::future_error &e) { thrown = e.code() == std::future_errc::future_already_retrieved; }
+        CHECK(thrown);
+
+        promise.set_value(1);
+        thrown = false;
+        try { promise.set_value(2); }
+        catch (const std::future_error &e) { thrown = e.code() == std::future_errc::promise_already_satisfied; }
+        CHECK(thrown);
+
+        CHECK(future.get() == 1);
+        CHECK(throws_future_error(future, std::future_errc::no_state));
+    }
+
+    // broken promise
+    {
+        Future<std::string> future;
+        {
+            Promise<std::string> promise;
+            future = promise.get_future();
+        }
+        CHECK(future.is_ready());
+        CHECK(throws_future_error(future, std::future_errc::broken_promise));
+    }
+
+    // then chain, continuations added before and after the result is available
+    {
+        Promise<int> promise;
+        auto future = promise.get_future()
+                .then([](Future<int> f) { return f.get() + 1; })
+                .then([](Future<int> f) { return std::to_string(f.get()); });
+        promise.set_value(1);
+        auto last = future.then([](Future<std::string> f) { return f.get() + "!"; });
+        CHECK(last.is_ready());
+        CHECK(last.get() == "2!");
+    }
+
+    // exception propagation through a chain: a continuation can handle it
+    {
+        Promise<void> promise;
+        bool skipped_called = false;
+        auto future = promise.get_future()
+                .then([&](Future<void> f) { f.get(); skipped_called = true; return 1; })
+                .then([](Future<int> f)
+                {
+                    try { return f.get(); }
+                    catch (const std::runtime_error &) { return -1; }
+                });
+        promise.set_exception(std::make_exception_ptr(std::runtime_error("failed")));
+        CHECK(future.get() == -1);
+        CHECK(!skipped_called);
+
+        // an exception thrown by a continuation becomes the result
+        Promise<int> second;
+        auto thrower = second.get_future().then([](Future<int>) -> int { throw std::logic_error("continuation"); });
+        second.set_value(0);
+        bool thrown = false;
+        try { thrower.get(); } catch (const std::logic_error &) { thrown = true; }
+        CHECK(thrown);
+    }
+
+    // when_all
+    {
+        std::vector<Promise<int>> promises(3);
+        std::vector<Future<int>> futures;
+        for (auto &promise : promises)
+            futures.push_back(promise.get_future());
+
+        auto all = when_all(std::move(futures));
+        promises[2].set_value(2);
+        promises[0].set_value(0);
+        CHECK(!all.is_ready());
+        promises[1].set_exception(std::make_exception_ptr(std::runtime_error("failed")));
+
+        auto results = all.get();
+        CHECK(results.size() == 3);
+        CHECK(results[0].get() == 0);
+        CHECK(results[2].get() == 2);
+        bool thrown = false;
+        try { results[1].get(); } catch (const std::runtime_error &) { thrown = true; }
+        CHECK(thrown);
+
+        auto empty = when_all(std::vector<Future<int>>());
+        CHECK(empty.is_ready());
+        CHECK(empty.get().empty());
+    }
+
+    // when_any: the futures that lost can be used with then() and another when_any()
+    {
+        std::vector<Promise<int>> promises(3);
+        std::vector<Future<int>> futures;
+        for (auto &promise : promises)
+            futures.push_back(promise.get_future());
+
+        auto any = when_any(std::move(futures));
+        promises[1].set_value(1);
+        auto first = any.get();
+        CHECK(first.index == 1);
+        CHECK(first.futures[1].get() == 1);
+
+        auto next = first.futures[0].then([](Future<int> f) { return f.get() * 10; });
+        std::vector<Future<int>> rest;
+        rest.push_back(std::move(first.futures[2]));
+        auto second_any = when_any(std::move(rest));
+
+        promises[2].set_value(2);
+        promises[0].set_value(3);
+        auto second = second_any.get();
+        CHECK(second.index == 0);
+        CHECK(second.futures[0].get() == 2);
+        CHECK(next.get() == 30);
+
+        bool thrown = false;
+        try { when_any(std::vector<Future<int>>()); } catch (const std::invalid_argument &) { thrown = true; }
+        CHECK(thrown);
+    }
+
+    // then(executor, function): the continuation is executed by a worker of the pool
+    {
+        ThreadPool pool(2, 4);
+        Promise<int> promise;
+        const pthread_t caller = pthread_self();
+        auto future = promise.get_future().then(pool, [caller](Future<int> f)
+        {
+            if (pthread_equal(caller, pthread_self())) throw std::logic_error("executed by the caller");
+            return f.get() * 2;
+        });
+        promise.set_value(21);
+        CHECK(future.get() == 42);
+
+        // submitting to a stopped pool fails: the exception becomes the result
+        pool.shutdown();
+        Promise<int> late;
+        auto rejected = late.get_future().then(pool, [](Future<int> f) { return f.get(); });
+        late.set_value(0);
+        bool thrown = false;
+        try { rejected.get(); } catch (const std::exception &) { thrown = true; }
+        CHECK(thrown);
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * \file test_light_semaphore.cpp
+ * \brief Test: LightSemaphore waits, timeouts and posts
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "LightSemaphore.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+int main( )
+{
+    constexpr unsigned int MAX_VALUE = 3;
+    LightSemaphore semaphore(MAX_VALUE);
+
+    // acquire all accesses, further attempts fail
+    for (unsigned int i = 0; i < MAX_VALUE; ++i)
+        CHECK(semaphore.trywait());
+    CHECK(semaphore.get_current_value() == MAX_VALUE);
+    CHECK(!semaphore.trywait());
+    CHECK(!semaphore.timedwait(test::milliseconds(20)));
+    CHECK(semaphore.get_thread_queue() == 0);
+
+    // suspended threads are woken by post
+    std::atomic<unsigned int> acquired(0);
+    std::vector<Thread> threads;
+    for (unsigned int t = 0; t < MAX_VALUE; ++t)
+    {
+        threads.emplace_back([&]( )
+        {
+            semaphore.wait();
+            acquired++;
+        });
+        threads.back().start();
+    }
+
+    test::spin_until([&]( ) { return semaphore.get_thread_queue() == MAX_VALUE; });
+    for (unsigned int i = 0; i < MAX_VALUE; ++i)
+        semaphore.post();
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(acquired.load() == MAX_VALUE);
+    CHECK(semaphore.get_current_value() == MAX_VALUE);
+    CHECK(semaphore.get_thread_queue() == 0);
+
+    for (unsigned int i = 0; i < MAX_VALUE; ++i)
+        semaphore.post();
+    CHECK(semaphore.get_current_value() == 0);
+
+    // more posts than waits
+    bool thrown = false;
+    try { semaphore.post(); } catch (const std::logic_error &) { thrown = true; }
+    CHECK(thrown);
+}
@@ -0,0 +1,97 @@
+/*
+ * \file test_parallel.cpp
+ * \brief Test: results of parallel_for, parallel_reduce and parallel_scan
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Parallel.hpp"
+#include "Scheduler.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+int main( )
+{
+    // more workers than CPUs: the blocks are processed by different threads
+    Scheduler scheduler(4);
+
+    // empty ranges: the functions are not called
+    std::atomic<int> calls(0);
+    parallel_for(10, 10, [&](int) { calls++; }, 0, scheduler);
+    parallel_for(10, 5, [&](int) { calls++; }, 1, scheduler);
+    CHECK(parallel_reduce(3, 3, 42, [&](int e) { calls++; return e; }, [](int a, int b) { return a + b; }, 0,
+            scheduler) == 42);
+    std::vector<int> empty;
+    parallel_scan(empty.begin(), empty.end(), empty.begin(), 0, [&](int a, int b) { calls++; return a + b; }, 0,
+            scheduler);
+    CHECK(calls.load() == 0);
+
+    // parallel_for with grain 1 visits every element once
+    constexpr int SIZE = 1000;
+    std::vector<std::atomic<int>> visits(SIZE);
+    for (auto &visit : visits)
+        visit = 0;
+    parallel_for(0, SIZE, [&](int i) { visits[static_cast<std::size_t>(i)]++; }, 1, scheduler);
+    for (auto &visit : visits)
+        CHECK(visit.load() == 1);
+
+    // non-commutative reduce: the order of the elements is preserved
+    std::string expected;
+    for (int i = 0; i < 100; ++i)
+        expected += static_cast<char>('a' + i % 26);
+    for (std::size_t grain : {std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(1000)})
+    {
+        auto result = parallel_reduce(0, 100, std::string(),
+                [](int i) { return std::string(1, static_cast<char>('a' + i % 26)); },
+                [](const std::string &a, const std::string &b) { return a + b; }, grain, scheduler);
+        CHECK(result == expected);
+    }
+
+    // inclusive scan of an index range, grain 1 (one block per element)
+    std::vector<long> sums(SIZE);
+    parallel_scan(0, SIZE, sums.begin(), 0L, [](long a, long b) { return a + b; }, 1, scheduler);
+    for (int i = 0; i < SIZE; ++i)
+        CHECK(sums[static_cast<std::size_t>(i)] == static_cast<long>(i) * (i + 1) / 2);
+
+    // in place scan, non-commutative operation
+    std::vector<std::string> words;
+    for (int i = 0; i < 50; ++i)
+        words.push_back(std::to_string(i % 10));
+    parallel_scan(words.begin(), words.end(), words.begin(), std::string(),
+            [](const std::string &a, const std::string &b) { return a + b; }, 3, scheduler);
+    std::string prefix;
+    for (int i = 0; i < 50; ++i)
+    {
+        prefix += std::to_string(i % 10);
+        CHECK(words[static_cast<std::size_t>(i)] == prefix);
+    }
+
+    // scan with T = bool (logical or): the block prefixes are not packed into shared words
+    std::vector<int> flags(SIZE, 0);
+    flags[SIZE / 2] = 1;
+    std::vector<int> seen(SIZE);
+    parallel_scan(flags.begin(), flags.end(), seen.begin(), false, [](bool a, int b) { return a || b != 0; }, 8,
+            scheduler);
+    for (int i = 0; i < SIZE; ++i)
+        CHECK((seen[static_cast<std::size_t>(i)] != 0) == (i >= SIZE / 2));
+
+    // exceptions are rethrown
+    bool thrown = false;
+    try
+    {
+        parallel_for(0, SIZE, [](int i) { if (i == SIZE - 1) throw std::runtime_error("failed"); }, 1, scheduler);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
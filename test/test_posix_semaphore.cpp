@@ -0,0 +1,66 @@
+/*
+ * \file test_posix_semaphore.cpp
+ * \brief Test: timed waits of SharedSemaphore and NamedSemaphore
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "NamedSemaphore.hpp"
+#include "SharedSemaphore.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! the timeout expires after the time span, a post from another thread ends the wait
+template<typename Semaphore>
+void test_timedwait(Semaphore &semaphore)
+{
+    CHECK(semaphore.trywait());
+    CHECK(!semaphore.trywait());
+
+    const auto start = test::steady_clock::now();
+    CHECK(!semaphore.timedwait(test::milliseconds(50)));
+    const double waited_us = test::elapsed_us(start);
+    CHECK(waited_us >= 50000);
+    CHECK(waited_us < 5000000);
+
+    Thread poster([&]( )
+    {
+        usleep(20000);
+        semaphore.post();
+    });
+    poster.start();
+    CHECK(semaphore.timedwait(test::milliseconds(10000)));
+    poster.join();
+
+    struct timespec invalid;
+    invalid.tv_sec = 0;
+    invalid.tv_nsec = -1;
+    bool thrown = false;
+    try { semaphore.timedwait(invalid); } catch (const std::invalid_argument &) { thrown = true; }
+    CHECK(thrown);
+
+    semaphore.post();
+    CHECK(semaphore.get_value() == 1);
+}
+
+} /* namespace */
+
+int main( )
+{
+    SharedSemaphore shared(1);
+    test_timedwait(shared);
+
+    const std::string name = "/test_posix_semaphore_" + std::to_string(getpid());
+    NamedSemaphore named(name, 1, NamedSemaphore::CREATE);
+    test_timedwait(named);
+    named.unlink();
+}
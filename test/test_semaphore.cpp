@@ -0,0 +1,174 @@
+/*
+ * \file test_semaphore.cpp
+ * \brief Test: Semaphore acquires and releases n accesses at once
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Semaphore.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <climits>
+#include <stdexcept>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+constexpr unsigned int MAX_VALUE = 8;
+
+//! threads acquire random numbers of accesses, the held accesses never exceed the maximum value
+void test_mixed( )
+{
+    Semaphore semaphore(MAX_VALUE);
+    std::atomic<unsigned int> held(0);
+    std::atomic<bool> exceeded(false);
+
+    std::vector<Thread> threads;
+    for (unsigned int t = 0; t < 6; ++t)
+    {
+        threads.emplace_back([&, t]( )
+        {
+            unsigned int seed = t;
+            for (unsigned int i = 0; i < 2000; ++i)
+            {
+                seed = seed * 1103515245 + 12345;
+                const unsigned int n = 1 + (seed >> 16) % MAX_VALUE;
+
+                switch (i % 3)
+                {
+                    case 0:
+                        semaphore.wait(n);
+                        break;
+                    case 1:
+                        if (!semaphore.trywait(n)) continue;
+                        break;
+                    default:
+                        if (!semaphore.timedwait(n, test::milliseconds(1))) continue;
+                        break;
+                }
+
+                if (held.fetch_add(n) + n > MAX_VALUE) exceeded = true;
+                sched_yield();
+                held.fetch_sub(n);
+                semaphore.post(n);
+            }
+        });
+        threads.back().start();
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(!exceeded.load());
+    const auto snapshot = semaphore.get_snapshot();
+    CHECK(snapshot.current_value == 0);
+    CHECK(snapshot.available == MAX_VALUE);
+    CHECK(snapshot.thread_queue == 0);
+}
+
+//! one post of all accesses wakes every waiter that can continue
+void test_post_many( )
+{
+    Semaphore semaphore(MAX_VALUE);
+    semaphore.wait(MAX_VALUE);
+
+    std::atomic<unsigned int> acquired(0);
+    std::vector<Thread> threads;
+    for (unsigned int n : {1u, 3u, 4u})
+    {
+        threads.emplace_back([&, n]( )
+        {
+            semaphore.wait(n);
+            acquired += n;
+        });
+        threads.back().start();
+    }
+
+    test::spin_until([&]( ) { return semaphore.get_thread_queue() == 3; });
+    CHECK(semaphore.get_snapshot().available == 0);
+
+    semaphore.post(MAX_VALUE);
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(acquired.load() == MAX_VALUE);
+    CHECK(semaphore.get_current_value() == MAX_VALUE);
+}
+
+//! wait(MAX_VALUE) is not starved by threads that constantly acquire and release single accesses
+void test_large_waiter( )
+{
+    Semaphore semaphore(MAX_VALUE);
+    std::atomic<bool> done(false);
+    std::atomic<unsigned long> iterations(0);
+
+    std::vector<Thread> threads;
+    for (unsigned int t = 0; t < MAX_VALUE; ++t)
+    {
+        threads.emplace_back([&]( )
+        {
+            while (!done.load())
+            {
+                semaphore.wait();
+                iterations++;
+                sched_yield();
+                semaphore.post();
+            }
+        });
+        threads.back().start();
+    }
+
+    test::spin_until([&]( ) { return iterations.load() > 1000; });
+
+    CHECK(semaphore.timedwait(MAX_VALUE, test::milliseconds(10000)));
+    CHECK(semaphore.get_current_value() == MAX_VALUE);
+    const auto before = iterations.load();
+    semaphore.post(MAX_VALUE);
+
+    // the small acquirers continue afterwards
+    test::spin_until([&]( ) { return iterations.load() > before + 1000; });
+    done = true;
+    for (auto &thread : threads)
+        thread.join();
+
+    CHECK(semaphore.get_current_value() == 0);
+    CHECK(semaphore.get_thread_queue() == 0);
+}
+
+//! timeouts and invalid arguments
+void test_errors( )
+{
+    Semaphore semaphore(2);
+    semaphore.wait(2);
+    CHECK(!semaphore.trywait());
+    CHECK(!semaphore.timedwait(test::milliseconds(20)));
+    semaphore.post(2);
+
+    bool thrown = false;
+    try { semaphore.post(); } catch (const std::logic_error &) { thrown = true; }
+    CHECK(thrown);
+
+    thrown = false;
+    try { semaphore.wait(3); } catch (const std::invalid_argument &) { thrown = true; }
+    CHECK(thrown);
+
+    thrown = false;
+    try { Semaphore too_large(static_cast<unsigned int>(INT_MAX) + 1); }
+    catch (const std::invalid_argument &) { thrown = true; }
+    CHECK(thrown);
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_mixed();
+    test_post_many();
+    test_large_waiter();
+    test_errors();
+}
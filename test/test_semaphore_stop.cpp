@@ -0,0 +1,144 @@
+/*
+ * \file test_semaphore_stop.cpp
+ * \brief Test: threads blocked in Semaphore::wait(const StopToken&, unsigned int) do not consume CPU time and are
+ *        woken individually
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Semaphore.hpp"
+#include "StopToken.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <memory>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! CPU time (ms) that a thread may consume while it is blocked for 500 ms
+constexpr double MAX_BLOCKED_CPU_MS = 50;
+
+/*! a stop aware waiter for n accesses blocks until the accesses are posted
+ *
+ * attributes:
+ *      - n   : accesses the waiter requests
+ *      - stop: true: interrupt the waiter by a stop request, false: post the accesses
+ */
+void test_blocked(unsigned int n, bool stop)
+{
+    Semaphore semaphore(4);
+    StopSource source;
+
+    // leave n - 1 accesses available
+    semaphore.wait(4 - n + 1);
+
+    std::atomic<bool> waiting(false);
+    std::atomic<int> result(-1);
+    double cpu_ms = 0;
+
+    Thread waiter([&]( )
+    {
+        const double start = test::thread_cpu_ms();
+        waiting = true;
+        result = semaphore.wait(source.get_token(), n) ? 1 : 0;
+        cpu_ms = test::thread_cpu_ms() - start;
+        if (result.load() == 1) semaphore.post(n);
+    });
+    waiter.start();
+
+    test::spin_until([&]( ) { return waiting.load() && semaphore.get_thread_queue() == 1; });
+    usleep(500000);
+    CHECK(result.load() == -1);
+
+    // another thread that does not get all accesses must not wake the waiter permanently
+    CHECK(!semaphore.trywait(n));
+
+    if (stop) source.request_stop();
+    else semaphore.post(4 - n + 1);
+
+    waiter.join();
+    CHECK(result.load() == (stop ? 0 : 1));
+    CHECK(cpu_ms < MAX_BLOCKED_CPU_MS);
+
+    if (stop) semaphore.post(4 - n + 1);
+    CHECK(semaphore.get_current_value() == 0);
+}
+
+//! voluntary context switches of the calling thread (one per suspension)
+long context_switches( )
+{
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_nvcsw;
+}
+
+//! a stop request and a post of one access wake one stop aware waiter, not all of them
+void test_individual_wakeup( )
+{
+    constexpr unsigned int WAITERS = 16;
+
+    // suspensions of a waiter: the wait itself and possibly the internal lock of the semaphore
+    constexpr long MAX_SUSPENSIONS = 3;
+
+    Semaphore semaphore(WAITERS);
+    semaphore.wait(WAITERS);
+
+    std::vector<StopSource> sources(WAITERS);
+    std::vector<long> switches(WAITERS, 0);
+    std::atomic<unsigned int> acquired(0);
+    std::vector<std::unique_ptr<Thread>> waiters;
+    for (unsigned int i = 0; i < WAITERS; ++i)
+    {
+        waiters.emplace_back(new Thread([&, i]( )
+        {
+            const long start = context_switches();
+            const bool success = semaphore.wait(sources[i].get_token());
+            switches[i] = context_switches() - start;
+            if (success) acquired++;
+        }));
+        waiters.back()->start();
+    }
+
+    test::spin_until([&]( ) { return semaphore.get_thread_queue() == WAITERS; });
+
+    // the stop removes only the stopped thread from the queue
+    sources[0].request_stop();
+    waiters[0]->join();
+    CHECK(semaphore.get_thread_queue() == WAITERS - 1);
+
+    // every post is handed to one waiter (which keeps it), the others stay suspended
+    for (unsigned int i = 1; i < WAITERS; ++i)
+    {
+        semaphore.post();
+        test::spin_until([&]( ) { return acquired.load() == i; });
+    }
+
+    for (unsigned int i = 1; i < WAITERS; ++i)
+        waiters[i]->join();
+
+    CHECK(acquired.load() == WAITERS - 1);
+    for (auto count : switches)
+        CHECK(count <= MAX_SUSPENSIONS);
+
+    // one access is still held by this thread, the others by the terminated waiters
+    CHECK(semaphore.get_current_value() == WAITERS);
+    CHECK(semaphore.get_thread_queue() == 0);
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_blocked(1, false);
+    test_blocked(2, false);
+    test_blocked(2, true);
+    test_blocked(4, true);
+    test_individual_wakeup();
+}
@@ -0,0 +1,86 @@
+/*
+ * \file test_shared_condition.cpp
+ * \brief Test: SharedCondition between processes, takeover of the mutex from a terminated process
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "SharedCondition.hpp"
+#include "test.hpp"
+
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! object in shared memory
+struct shared_t
+{
+    SharedCondition condition;
+    int value = 0;
+};
+
+//! wait for the termination of a child process, true if it exited with code 0
+bool child_succeeded(pid_t child)
+{
+    int status;
+    if (waitpid(child, &status, 0) != child) return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} /* namespace */
+
+int main( )
+{
+    void *memory = mmap(nullptr, sizeof(shared_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    CHECK(memory != MAP_FAILED);
+    auto shared = new (memory) shared_t;
+
+    // the child signals the parent
+    pid_t child = fork();
+    CHECK(child >= 0);
+    if (child == 0)
+    {
+        shared->condition.lock();
+        shared->value = 1;
+        shared->condition.broadcast();
+        shared->condition.unlock();
+        _exit(0);
+    }
+
+    shared->condition.lock();
+    CHECK(shared->condition.wait_for(test::milliseconds(10000), [&]( ) { return shared->value == 1; }));
+    CHECK(!shared->condition.owner_died());
+    shared->condition.unlock();
+    CHECK(child_succeeded(child));
+
+    // the child terminates while it holds the mutex: the parent takes it over instead of blocking forever
+    child = fork();
+    CHECK(child >= 0);
+    if (child == 0)
+    {
+        shared->condition.lock();
+        shared->value = 2;
+        _exit(0);
+    }
+    CHECK(child_succeeded(child));
+
+    shared->condition.lock();
+    CHECK(shared->condition.owner_died());
+    CHECK(!shared->condition.owner_died());
+    CHECK(shared->value == 2);
+    shared->condition.unlock();
+
+    // the mutex is consistent again
+    CHECK(shared->condition.trylock());
+    CHECK(!shared->condition.owner_died());
+    shared->condition.unlock();
+
+    shared->~shared_t();
+    munmap(memory, sizeof(shared_t));
+}
@@ -0,0 +1,109 @@
+/*
+ * \file test_stack_pool.cpp
+ * \brief Test: threads on stacks of a StackPool, reuse of released stacks
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "StackPool.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <pthread.h>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! check whether the address of a local variable of the calling thread is within [stack, stack + size)
+bool on_stack(const void *stack, std::size_t size)
+{
+    const char local = 0;
+    const auto address = reinterpret_cast<std::uintptr_t>(&local);
+    const auto base = reinterpret_cast<std::uintptr_t>(stack);
+    return address >= base && address < base + size;
+}
+
+//! stack the thread function is expected to run on
+const void *expected_stack = nullptr;
+
+//! usable size of expected_stack
+std::size_t expected_size = 0;
+
+//! number of runs of thread_function on expected_stack
+int runs_on_stack = 0;
+
+//! thread function (a Thread with a thread function can be restarted)
+void* thread_function(void*)
+{
+    if (on_stack(expected_stack, expected_size)) runs_on_stack++;
+    return nullptr;
+}
+
+} /* namespace */
+
+int main( )
+{
+    constexpr std::size_t STACK_SIZE = 256 * 1024;
+    StackPool pool(STACK_SIZE, 2);
+    CHECK(pool.get_stack_size() >= STACK_SIZE);
+    CHECK(pool.get_cached_count() == 0);
+    CHECK(pool.get_acquired_count() == 0);
+
+    // the stack that is released last is handed out first
+    void *stack = pool.acquire();
+    CHECK(pool.get_acquired_count() == 1);
+    pool.release(stack);
+    CHECK(pool.get_cached_count() == 1);
+    CHECK(pool.get_acquired_count() == 0);
+
+    {
+        expected_stack = stack;
+        expected_size = pool.get_stack_size();
+        Thread thread(thread_function);
+        thread.set_stack(pool);
+        CHECK(pool.get_cached_count() == 0);
+        CHECK(pool.get_acquired_count() == 1);
+
+        thread.start();
+        thread.join();
+        CHECK(runs_on_stack == 1);
+
+        // the joined thread keeps its stack: a restart runs on the same stack
+        CHECK(pool.get_acquired_count() == 1);
+        thread.start();
+        thread.join();
+        CHECK(runs_on_stack == 2);
+        CHECK(pool.get_acquired_count() == 1);
+    }
+
+    // destroying the Thread object returns the stack
+    CHECK(pool.get_cached_count() == 1);
+    CHECK(pool.get_acquired_count() == 0);
+
+    // more threads than cached stacks: the surplus stacks are unmapped when they are released
+    {
+        std::atomic<int> finished(0);
+        std::vector<Thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&finished]( ) { finished++; });
+            threads.back().set_stack(pool);
+        }
+        CHECK(pool.get_cached_count() == 0);
+        CHECK(pool.get_acquired_count() == 4);
+
+        for (auto &thread : threads)
+            thread.start();
+        for (auto &thread : threads)
+            thread.join();
+        CHECK(finished.load() == 4);
+    }
+
+    CHECK(pool.get_cached_count() == 2);
+    CHECK(pool.get_acquired_count() == 0);
+}
@@ -0,0 +1,214 @@
+/*
+ * \file test_thread_scheduling.cpp
+ * \brief Test: scheduling policy, SCHED_DEADLINE parameters and nice value of a Thread
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! uid/gid of the unprivileged user (nobody)
+constexpr uid_t NOBODY = 65534;
+
+//! true: the thread function shall return
+std::atomic<bool> finish(false);
+
+//! true: the thread function was executed
+std::atomic<bool> executed(false);
+
+//! runs until finish is set
+void* thread_function(void*)
+{
+    executed = true;
+    while (!finish.load())
+        sched_yield();
+    return nullptr;
+}
+
+//! check that a call throws std::invalid_argument, message must contain text
+template<typename Call>
+bool throws_invalid_argument(Call call, const std::string &text = std::string( ))
+{
+    try
+    {
+        call();
+    }
+    catch (const std::invalid_argument &e)
+    {
+        return std::string(e.what()).find(text) != std::string::npos;
+    }
+    return false;
+}
+
+//! check that a call fails because of missing privileges and that the message explains it
+template<typename Call>
+bool permission_denied(Call call)
+{
+    try
+    {
+        call();
+    }
+    catch (const std::system_error &e)
+    {
+        return (e.code().value() == EPERM || e.code().value() == EACCES)
+                && std::string(e.what()).find("insufficient privileges") != std::string::npos;
+    }
+    return false;
+}
+
+//! time span of us microseconds
+struct timespec microseconds(long us)
+{
+    struct timespec time;
+    time.tv_sec = us / 1000000;
+    time.tv_nsec = us % 1000000 * 1000;
+    return time;
+}
+
+//! invalid arguments are rejected before anything is changed
+void test_arguments( )
+{
+    Thread thread(thread_function);
+
+    CHECK(throws_invalid_argument([&]( ) { thread.set_scheduling(Thread::DEADLINE); }, "set_deadline"));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_scheduling(static_cast<Thread::policy_t>(7)); }));
+
+    // priority range of the policy
+    CHECK(throws_invalid_argument([&]( ) { thread.set_scheduling(Thread::OTHER, 1); }, "(0 - 0)"));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_scheduling(Thread::BATCH, 1); }));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_scheduling(Thread::FIFO, 0); }, "out of range"));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_scheduling(Thread::RR, sched_get_priority_max(SCHED_RR) + 1); }));
+    CHECK(thread.get_policy() == Thread::OTHER);
+
+    // accepted before start(): stored for the new thread
+    thread.set_scheduling(Thread::FIFO, sched_get_priority_max(SCHED_FIFO));
+    CHECK(thread.get_policy() == Thread::FIFO);
+    CHECK(thread.get_priority() == sched_get_priority_max(SCHED_FIFO));
+    thread.set_scheduling(Thread::OTHER);
+    CHECK(thread.get_policy() == Thread::OTHER);
+    CHECK(thread.get_priority() == 0);
+
+    // nice range
+    CHECK(throws_invalid_argument([&]( ) { thread.set_nice(-21); }, "nice value -21"));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_nice(20); }));
+
+    // SCHED_DEADLINE requires 0 < runtime <= deadline <= period
+    const auto zero = microseconds(0);
+    const auto small = microseconds(1000);
+    const auto large = microseconds(10000);
+    CHECK(throws_invalid_argument([&]( ) { thread.set_deadline(zero, small, large); }, "SCHED_DEADLINE"));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_deadline(large, small, large); }));
+    CHECK(throws_invalid_argument([&]( ) { thread.set_deadline(small, large, small); }));
+    struct timespec invalid = small;
+    invalid.tv_nsec = -1;
+    CHECK(throws_invalid_argument([&]( ) { thread.set_deadline(invalid, large, large); }));
+    CHECK(thread.get_policy() == Thread::OTHER);
+
+    // a deadline policy is replaced by set_scheduling
+    thread.set_deadline(small, small, large);
+    CHECK(thread.get_policy() == Thread::DEADLINE);
+    thread.set_scheduling(Thread::OTHER);
+    CHECK(thread.get_policy() == Thread::OTHER);
+}
+
+//! the nice value is applied by the started thread and can be changed while it is running
+void test_nice( )
+{
+    const int own_nice = getpriority(PRIO_PROCESS, 0);
+
+    finish = false;
+    Thread thread(thread_function);
+    thread.set_nice(5);
+    CHECK(thread.get_nice() == 5);
+    thread.start();
+
+    const auto tid = static_cast<id_t>(thread.get_tid());
+    CHECK(tid != 0);
+    CHECK(getpriority(PRIO_PROCESS, tid) == 5);
+    CHECK(thread.get_nice() == 5);
+
+    thread.set_nice(10);
+    CHECK(getpriority(PRIO_PROCESS, tid) == 10);
+    CHECK(thread.get_nice() == 10);
+
+    // only the started thread is affected
+    CHECK(getpriority(PRIO_PROCESS, 0) == own_nice);
+
+    finish = true;
+    thread.join();
+}
+
+/*! without CAP_SYS_NICE and with RLIMIT_RTPRIO / RLIMIT_NICE 0, real-time policies and lower nice values are rejected
+ *  with an explanation (executed by a child process)
+ */
+void test_unprivileged( )
+{
+    const struct rlimit no_limit = { 0, 0 };
+    CHECK(setrlimit(RLIMIT_RTPRIO, &no_limit) == 0);
+    CHECK(setrlimit(RLIMIT_NICE, &no_limit) == 0);
+
+    // root: drop all capabilities by switching to an unprivileged user
+    if (geteuid() == 0 && (setgid(NOBODY) != 0 || setuid(NOBODY) != 0))
+    {
+        std::cerr << "switching to an unprivileged user is not possible, test skipped" << std::endl;
+        return;
+    }
+
+    // applied by pthread_create: the thread is not started, but can be started with other settings
+    finish = false;
+    executed = false;
+    Thread thread(thread_function);
+    thread.set_scheduling(Thread::FIFO, 1);
+    CHECK(permission_denied([&]( ) { thread.start(); }));
+    CHECK(!executed.load());
+    thread.set_scheduling(Thread::OTHER);
+
+    // applied by the started thread: the thread function is not executed
+    thread.set_nice(-1);
+    CHECK(permission_denied([&]( ) { thread.start(); }));
+    CHECK(!executed.load());
+    thread.set_nice(getpriority(PRIO_PROCESS, 0));
+
+    thread.start();
+    CHECK(permission_denied([&]( ) { thread.set_scheduling(Thread::RR, 1); }));
+    CHECK(permission_denied([&]( ) { thread.set_nice(-1); }));
+    CHECK(thread.get_policy() == Thread::OTHER);
+
+    finish = true;
+    thread.join();
+    CHECK(executed.load());
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_arguments();
+    test_nice();
+
+    pid_t child = fork();
+    CHECK(child >= 0);
+    if (child == 0)
+    {
+        test_unprivileged();
+        _exit(0);
+    }
+    int status;
+    CHECK(waitpid(child, &status, 0) == child);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
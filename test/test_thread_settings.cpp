@@ -0,0 +1,106 @@
+/*
+ * \file test_thread_settings.cpp
+ * \brief Test: affinity, name and CPU time of joinable and detached threads, Topology
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Thread.hpp"
+#include "Topology.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! true: the thread function shall return
+std::atomic<bool> finish(false);
+
+//! runs until finish is set
+void* thread_function(void*)
+{
+    while (!finish.load())
+        sched_yield();
+    return nullptr;
+}
+
+//! check that a call throws std::logic_error
+template<typename Call>
+bool throws_logic_error(Call call)
+{
+    try
+    {
+        call();
+    }
+    catch (const std::logic_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+//! the settings of a running joinable thread are accessible
+void test_joinable( )
+{
+    finish = false;
+    Thread thread(thread_function);
+    thread.set_name("joinable");
+    thread.start();
+
+    CHECK(thread.get_name() == "joinable");
+    CHECK(!thread.get_affinity().empty());
+    thread.get_cpu_time();
+    thread.get_policy();
+
+    finish = true;
+    thread.join();
+}
+
+//! a detached thread might have terminated: its settings are not accessed
+void test_detached( )
+{
+    finish = false;
+    Thread thread(thread_function, Thread::DETACHED);
+    thread.start();
+
+    CHECK(throws_logic_error([&]( ) { thread.get_affinity(); }));
+    CHECK(throws_logic_error([&]( ) { thread.set_affinity(thread.get_my_affinity()); }));
+    CHECK(throws_logic_error([&]( ) { thread.get_policy(); }));
+    CHECK(throws_logic_error([&]( ) { thread.get_priority(); }));
+    CHECK(throws_logic_error([&]( ) { thread.get_nice(); }));
+    CHECK(throws_logic_error([&]( ) { thread.set_nice(0); }));
+    CHECK(throws_logic_error([&]( ) { thread.set_scheduling(Thread::OTHER); }));
+    CHECK(throws_logic_error([&]( ) { thread.get_name(); }));
+    CHECK(throws_logic_error([&]( ) { thread.set_name("detached"); }));
+    CHECK(throws_logic_error([&]( ) { thread.get_cpu_time(); }));
+
+    finish = true;
+}
+
+//! the topology contains only CPUs the calling thread may run on
+void test_topology( )
+{
+    const CpuSet allowed = Thread::get_my_affinity();
+    Topology topology;
+
+    CHECK(!topology.get_online().empty());
+    CHECK((topology.get_online() & allowed) == topology.get_online());
+    for (const auto &core : topology.get_cores())
+        CHECK((core & allowed) == core);
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_joinable();
+    test_detached();
+    test_topology();
+
+    // the detached thread must not access finish after main returned
+    test::spin_until([ ]( ) { return Thread::get_threads().size() == 0; });
+}
@@ -0,0 +1,80 @@
+/*
+ * \file test_thread_stop.cpp
+ * \brief Test: stop token of a Thread across moves and restarts
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <utility>
+
+using namespace de::Koesling::Threading;
+
+namespace {
+
+//! number of runs of thread_function that were not stopped when they started
+std::atomic<int> unstopped_starts(0);
+
+//! runs until a stop is requested
+void* thread_function(void*)
+{
+    const StopToken token = Thread::get_my_stop_token();
+    if (!token.stop_requested()) unstopped_starts++;
+
+    while (!token.stop_requested())
+        sched_yield();
+
+    return nullptr;
+}
+
+//! a thread that is started again is not stopped by the stop request of the previous run
+void test_restart( )
+{
+    Thread thread(thread_function);
+
+    for (int run = 1; run <= 3; ++run)
+    {
+        thread.start();
+        const StopToken token = thread.get_stop_token();
+        test::spin_until([&]( ) { return unstopped_starts.load() == run; });
+        CHECK(!token.stop_requested());
+
+        CHECK(thread.request_stop());
+        thread.join();
+        CHECK(token.stop_requested());
+    }
+}
+
+//! the moved Thread object stops the thread that was started by the original object
+void test_move( )
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        std::atomic<bool> stopped(false);
+        Thread thread([&](StopToken token)
+        {
+            while (!token.stop_requested())
+                sched_yield();
+            stopped = true;
+        });
+        thread.start();
+
+        // the thread might still start up while it is moved
+        Thread moved(std::move(thread));
+        CHECK(moved.request_stop());
+        moved.join();
+        CHECK(stopped.load());
+    }
+}
+
+} /* namespace */
+
+int main( )
+{
+    test_restart();
+    test_move();
+}
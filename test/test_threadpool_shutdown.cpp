@@ -0,0 +1,58 @@
+/*
+ * \file test_threadpool_shutdown.cpp
+ * \brief Test: concurrent ThreadPool::shutdown calls return once the worker threads were joined
+ *
+ * Copyright (c) 2020 Nikolas Koesling
+ *
+ */
+
+#include "ThreadPool.hpp"
+#include "Thread.hpp"
+#include "test.hpp"
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+using namespace de::Koesling::Threading;
+
+int main( )
+{
+    constexpr int CALLERS = 4;
+
+    ThreadPool pool(2, 8);
+
+    std::atomic<bool> task_started(false);
+    std::atomic<bool> task_done(false);
+    pool.submit([&]( )
+    {
+        task_started = true;
+        struct timespec duration = test::milliseconds(200);
+        nanosleep(&duration, nullptr);
+        task_done = true;
+    });
+    test::spin_until([&]( ) { return task_started.load(); });
+
+    // every caller (not only the one that joins the workers) returns after the running task completed
+    std::atomic<int> returned_early(0);
+    std::vector<std::unique_ptr<Thread>> callers;
+    for (int i = 0; i < CALLERS; ++i)
+    {
+        callers.emplace_back(new Thread([&]( )
+        {
+            pool.shutdown();
+            if (!task_done.load()) returned_early++;
+        }));
+        callers.back()->start();
+    }
+
+    for (auto &caller : callers)
+        caller->join();
+
+    CHECK(task_done.load());
+    CHECK(returned_early.load() == 0);
+
+    // calls after the join return immediately
+    pool.shutdown();
+}